@@ -0,0 +1,733 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      combwalker.cpp                                      *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the combWalker class.      *//
+//*  Every bead that moves is lifted off the lattice and put back   *//
+//*  down, and only the contacts it makes or breaks there are       *//
+//*  counted, so the energy costs O(1) per bead moved.              *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "combwalker.h"
+
+// Defines how far the centre of mass may drift before the whole
+// chain is moved back to the origin, keeping the moment sums small.
+const int WALKER_RECENTER_DISTANCE = 4096;
+
+// Lattice directions in the order growArm uses them
+const int WALKER_DIRECTION_X[4] = {0, 0, 1, -1};
+const int WALKER_DIRECTION_Y[4] = {1, -1, 0, 0};
+
+// Constructor for a walker. Only the bonds are taken from the sample,
+// the walker lays its own beads out.
+//
+combWalker::combWalker(sample* s, unsigned long long seed)
+{
+	beadCount = s->getBeadCount();
+	randomState = (seed != 0) ? seed : 1;
+	undoLength = 0;
+	occupancy = new occupancyGrid(beadCount);
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		bondCount[i] = 0;
+	}
+
+	for(int i = 1; i < beadCount; i++)
+	{
+		int j = s->getBondedBead(i);
+
+		bonds[i][bondCount[i]++] = j;
+		bonds[j][bondCount[j]++] = i;
+	}
+
+	layoutStraight();
+	rebuild();
+}
+
+// Destructor for a walker.
+//
+combWalker::~combWalker(void)
+{
+	delete occupancy;
+}
+
+// Lays the comb out as an H. The arms on the first branch point go up
+// and down, the backbone goes right to the second branch point, and
+// its arms go up and down again, so no two beads ever share a site.
+//
+void combWalker::layoutStraight()
+{
+	int stackStart[8], stackFrom[8], stackDirection[8];
+	int stackSize = 0;
+
+	beadsX[0] = 0;
+	beadsY[0] = 0;
+
+	// The backbone is whichever arm ends at another branch point
+	int backbone = -1;
+
+	for(int k = 0; k < bondCount[0]; k++)
+	{
+		int from = 0, bead = bonds[0][k];
+
+		while(bondCount[bead] == 2)
+		{
+			int next = (bonds[bead][0] == from) ? bonds[bead][1]
+												: bonds[bead][0];
+			from = bead;
+			bead = next;
+		}
+
+		if(bondCount[bead] == 3)
+		{
+			backbone = k;
+		}
+	}
+
+	// Right for the backbone, then up and down for the arms
+	const int firstDirections[3] = {2, 0, 1};
+	int used = 0;
+
+	if(backbone >= 0)
+	{
+		stackStart[stackSize] = bonds[0][backbone];
+		stackFrom[stackSize] = 0;
+		stackDirection[stackSize] = firstDirections[used++];
+		stackSize++;
+	}
+
+	for(int k = 0; k < bondCount[0]; k++)
+	{
+		if(k != backbone)
+		{
+			stackStart[stackSize] = bonds[0][k];
+			stackFrom[stackSize] = 0;
+			stackDirection[stackSize] = firstDirections[used++];
+			stackSize++;
+		}
+	}
+
+	// Each arm runs straight on until it ends or branches, and any
+	// branches turn off to either side of it
+	while(stackSize > 0)
+	{
+		stackSize--;
+
+		int bead = stackStart[stackSize], from = stackFrom[stackSize];
+		int d = stackDirection[stackSize];
+
+		while(true)
+		{
+			beadsX[bead] = beadsX[from] + WALKER_DIRECTION_X[d];
+			beadsY[bead] = beadsY[from] + WALKER_DIRECTION_Y[d];
+
+			if(bondCount[bead] != 2)
+			{
+				break;
+			}
+
+			int next = (bonds[bead][0] == from) ? bonds[bead][1]
+												: bonds[bead][0];
+			from = bead;
+			bead = next;
+		}
+
+		if(bondCount[bead] == 3)
+		{
+			int side = (d < 2) ? 2 : 0;
+
+			for(int k = 0; k < 3; k++)
+			{
+				if(bonds[bead][k] != from)
+				{
+					stackStart[stackSize] = bonds[bead][k];
+					stackFrom[stackSize] = bead;
+					stackDirection[stackSize] = side++;
+					stackSize++;
+				}
+			}
+		}
+	}
+}
+
+// Works the contacts, moments and occupancy out again from the beads
+//
+void combWalker::rebuild()
+{
+	occupancy->clear();
+	clearMoments(total);
+	contacts = 0;
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		lifted[i] = true;
+	}
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		placeBead(i, beadsX[i], beadsY[i]);
+	}
+}
+
+// Proposes one move and applies it. Returns false when the move could
+// not be made, in which case nothing has changed. Otherwise accept or
+// undo must be called before the next move.
+//
+bool combWalker::tryMove()
+{
+	int i = random(beadCount);
+
+	undoLength = 0;
+
+	if(random(PIVOT_FRACTION) == 0)
+	{
+		return tryPivot(i);
+	}
+
+	// The pulls are weighted so a pull that drags an end along is as
+	// likely as the end pull that puts it back: 1/4 * 1/2 * 1/2 for a
+	// bead with two bonds, 3/4 * 1/4 * 1/3 for an end.
+	switch(bondCount[i])
+	{
+	case 1:
+		if(random(4) == 0)
+		{
+			return tryEndFlip(i);
+		}
+
+		return tryEndPull(i);
+
+	case 2:
+		switch(random(8))
+		{
+		case 0:
+		case 1:
+		case 2:
+			return tryCornerFlip(i);
+
+		case 3:
+		case 4:
+		case 5:
+			return tryCrankshaft(i);
+
+		default:
+			return tryPull(i);
+		}
+
+	default:
+		return false;
+	}
+}
+
+// Keeps the move just made
+//
+void combWalker::accept()
+{
+	undoLength = 0;
+
+	if(total.sx > (long long)WALKER_RECENTER_DISTANCE * total.n
+		|| total.sx < -(long long)WALKER_RECENTER_DISTANCE * total.n
+		|| total.sy > (long long)WALKER_RECENTER_DISTANCE * total.n
+		|| total.sy < -(long long)WALKER_RECENTER_DISTANCE * total.n)
+	{
+		recenter();
+	}
+}
+
+// Takes the move just made back. Every bead it moved is lifted first
+// and then put back where it was, so no bead is ever put down on top
+// of another.
+//
+void combWalker::undo()
+{
+	for(int k = undoLength - 1; k >= 0; k--)
+	{
+		if(!lifted[undoBead[k]])
+		{
+			liftBead(undoBead[k]);
+		}
+	}
+
+	for(int k = undoLength - 1; k >= 0; k--)
+	{
+		placeBead(undoBead[k], undoX[k], undoY[k]);
+	}
+
+	undoLength = 0;
+}
+
+// Moves an end bead to one of the four sites around the bead it is
+// bonded to.
+//
+bool combWalker::tryEndFlip(int i)
+{
+	int n = bonds[i][0], d = random(4);
+	int x = beadsX[n] + WALKER_DIRECTION_X[d];
+	int y = beadsY[n] + WALKER_DIRECTION_Y[d];
+
+	if(!isFree(x, y))
+	{
+		return false;
+	}
+
+	moveBead(i, x, y);
+
+	return true;
+}
+
+// Flips a corner bead across the diagonal of its two neighbours.
+//
+bool combWalker::tryCornerFlip(int i)
+{
+	int a = bonds[i][0], b = bonds[i][1];
+
+	if(abs(beadsX[a] - beadsX[b]) != 1 || abs(beadsY[a] - beadsY[b]) != 1)
+	{
+		return false;
+	}
+
+	int x = beadsX[a] + beadsX[b] - beadsX[i];
+	int y = beadsY[a] + beadsY[b] - beadsY[i];
+
+	if(!isFree(x, y))
+	{
+		return false;
+	}
+
+	moveBead(i, x, y);
+
+	return true;
+}
+
+// Turns a U made of a-i-j-b over to the other side of the a-b bond.
+//
+bool combWalker::tryCrankshaft(int i)
+{
+	int j = bonds[i][random(2)];
+
+	if(bondCount[j] != 2)
+	{
+		return false;
+	}
+
+	int a = (bonds[i][0] == j) ? bonds[i][1] : bonds[i][0];
+	int b = (bonds[j][0] == i) ? bonds[j][1] : bonds[j][0];
+
+	// i and j must stick out from a and b the same way, across the
+	// a-b bond
+	int dx = beadsX[i] - beadsX[a], dy = beadsY[i] - beadsY[a];
+	int ex = beadsX[j] - beadsX[i], ey = beadsY[j] - beadsY[i];
+
+	if(beadsX[j] - beadsX[b] != dx || beadsY[j] - beadsY[b] != dy
+		|| dx * ex + dy * ey != 0)
+	{
+		return false;
+	}
+
+	int ix = beadsX[a] - dx, iy = beadsY[a] - dy;
+	int jx = beadsX[b] - dx, jy = beadsY[b] - dy;
+
+	if(!isFree(ix, iy) || !isFree(jx, jy))
+	{
+		return false;
+	}
+
+	moveBead(i, ix, iy);
+	moveBead(j, jx, jy);
+
+	return true;
+}
+
+// Pulls bead i to the free site L next to one of its neighbours, the
+// anchor, and diagonal to where i is now. The bead behind i goes to
+// C, the fourth corner of the square i, anchor, L and C make, unless
+// it is already there, and the rest follow with followPull.
+//
+bool combWalker::tryPull(int i)
+{
+	int r = random(2);
+	int anchor = bonds[i][r], behind = bonds[i][1 - r];
+	int side = (random(2) == 0) ? 1 : -1;
+	int ux = beadsX[anchor] - beadsX[i], uy = beadsY[anchor] - beadsY[i];
+	int vx = -uy * side, vy = ux * side;
+	int lx = beadsX[anchor] + vx, ly = beadsY[anchor] + vy;
+	int cx = beadsX[i] + vx, cy = beadsY[i] + vy;
+
+	if(!isFree(lx, ly))
+	{
+		return false;
+	}
+
+	// With the bead behind already at C this is only a corner flip
+	if(beadsX[behind] == cx && beadsY[behind] == cy)
+	{
+		moveBead(i, lx, ly);
+		return true;
+	}
+
+	if(!isFree(cx, cy) || bondCount[behind] == 3)
+	{
+		return false;
+	}
+
+	int twoAheadX = beadsX[i], twoAheadY = beadsY[i];
+	int oneAheadX = beadsX[behind], oneAheadY = beadsY[behind];
+
+	moveBead(i, lx, ly);
+	moveBead(behind, cx, cy);
+
+	return followPull(i, behind, twoAheadX, twoAheadY, oneAheadX, 
+					  oneAheadY);
+}
+
+// Pulls an end bead two sites away: the bead next to it goes to a free
+// site A next to where the end is now, and the end goes to a free site
+// B next to A. The rest follow with followPull. This is the reverse of
+// a pull whose followers reach the end.
+//
+bool combWalker::tryEndPull(int i)
+{
+	int next = bonds[i][0];
+	int a = random(4), b = random(3);
+	int ax = beadsX[i] + WALKER_DIRECTION_X[a];
+	int ay = beadsY[i] + WALKER_DIRECTION_Y[a];
+
+	// B is one of the three sites around A other than the end itself
+	int d = 0;
+
+	for(int k = 0; k < 4; k++)
+	{
+		if(ax + WALKER_DIRECTION_X[k] == beadsX[i]
+			&& ay + WALKER_DIRECTION_Y[k] == beadsY[i])
+		{
+			continue;
+		}
+
+		if(b-- == 0)
+		{
+			d = k;
+			break;
+		}
+	}
+
+	int bx = ax + WALKER_DIRECTION_X[d], by = ay + WALKER_DIRECTION_Y[d];
+
+	// With B next to the bead after the end, the pull back would stop
+	// with the end still at B, so this pull would have no reverse
+	if(!isFree(ax, ay) || !isFree(bx, by) || bondCount[next] != 2
+		|| abs(bx - beadsX[next]) + abs(by - beadsY[next]) == 1)
+	{
+		return false;
+	}
+
+	int twoAheadX = beadsX[i], twoAheadY = beadsY[i];
+	int oneAheadX = beadsX[next], oneAheadY = beadsY[next];
+
+	moveBead(i, bx, by);
+	moveBead(next, ax, ay);
+
+	return followPull(i, next, twoAheadX, twoAheadY, oneAheadX, 
+					  oneAheadY);
+}
+
+// Finishes a pull once its first two beads have moved, the second of
+// them being from. Every bead after that goes to where the bead two
+// ahead of it was, until one is found still bonded to the bead ahead
+// of it or an end has followed. A branch point never follows, so the
+// move is undone if one would have to. The last bead moved can always
+// be pulled back the other way, which keeps a pull as likely as its
+// reverse.
+//
+bool combWalker::followPull(int first, int from, int twoAheadX, 
+							int twoAheadY, int oneAheadX, int oneAheadY)
+{
+	int bead = (bonds[from][0] == first) ? bonds[from][1] : bonds[from][0];
+
+	if(bondCount[from] == 1)
+	{
+		return true;
+	}
+
+	while(abs(beadsX[bead] - beadsX[from])
+		  + abs(beadsY[bead] - beadsY[from]) != 1)
+	{
+		if(bondCount[bead] == 3)
+		{
+			undo();
+			return false;
+		}
+
+		int oldX = beadsX[bead], oldY = beadsY[bead];
+
+		moveBead(bead, twoAheadX, twoAheadY);
+
+		if(bondCount[bead] == 1)
+		{
+			break;
+		}
+
+		twoAheadX = oneAheadX;
+		twoAheadY = oneAheadY;
+		oneAheadX = oldX;
+		oneAheadY = oldY;
+
+		int next = (bonds[bead][0] == from) ? bonds[bead][1] : bonds[bead][0];
+		from = bead;
+		bead = next;
+	}
+
+	return true;
+}
+
+// Picks one of bead i's bonds and turns or reflects everything on the
+// far side of it about bead i, with one of the seven symmetries of the
+// square other than doing nothing.
+//
+bool combWalker::tryPivot(int i)
+{
+	int first = bonds[i][random(bondCount[i])];
+	int symmetry = 1 + random(7);
+	int size = 0, done = 0;
+
+	// Lift the beads on the far side of the bond off the lattice. The
+	// comb has no loops, so only the way back to i needs to be kept
+	// out and the lifted flag says which beads have been reached.
+	branch[size++] = first;
+	undoBead[undoLength] = first;
+	undoX[undoLength] = beadsX[first];
+	undoY[undoLength] = beadsY[first];
+	undoLength++;
+	liftBead(first);
+
+	while(done < size)
+	{
+		int bead = branch[done++];
+
+		for(int k = 0; k < bondCount[bead]; k++)
+		{
+			int next = bonds[bead][k];
+
+			if(next != i && !lifted[next])
+			{
+				branch[size++] = next;
+				undoBead[undoLength] = next;
+				undoX[undoLength] = beadsX[next];
+				undoY[undoLength] = beadsY[next];
+				undoLength++;
+				liftBead(next);
+			}
+		}
+	}
+
+	// Put every bead down again at its turned site
+	for(int k = 0; k < size; k++)
+	{
+		int bead = branch[k];
+		int dx = beadsX[bead] - beadsX[i], dy = beadsY[bead] - beadsY[i];
+		int tx, ty;
+
+		switch(symmetry)
+		{
+		case 1:
+			tx = -dy;
+			ty = dx;
+			break;
+
+		case 2:
+			tx = -dx;
+			ty = -dy;
+			break;
+
+		case 3:
+			tx = dy;
+			ty = -dx;
+			break;
+
+		case 4:
+			tx = -dx;
+			ty = dy;
+			break;
+
+		case 5:
+			tx = dx;
+			ty = -dy;
+			break;
+
+		case 6:
+			tx = dy;
+			ty = dx;
+			break;
+
+		default:
+			tx = -dy;
+			ty = -dx;
+		}
+
+		if(!isFree(beadsX[i] + tx, beadsY[i] + ty))
+		{
+			undo();
+			return false;
+		}
+
+		placeBead(bead, beadsX[i] + tx, beadsY[i] + ty);
+	}
+
+	return true;
+}
+
+// Returns true when no bead sits on a site
+//
+bool combWalker::isFree(int x, int y)
+{
+	return occupancy->count(x, y) == 0;
+}
+
+// Counts the contacts bead i makes at a site: beads on the lattice
+// next to it that it is not bonded to.
+//
+int combWalker::countContacts(int i, int x, int y)
+{
+	int count = occupancy->countNeighbours(x, y);
+
+	for(int k = 0; k < bondCount[i]; k++)
+	{
+		int j = bonds[i][k];
+
+		if(!lifted[j] && abs(beadsX[j] - x) + abs(beadsY[j] - y) == 1)
+		{
+			count--;
+		}
+	}
+
+	return count;
+}
+
+// Takes a bead off the lattice along with its contacts
+//
+void combWalker::liftBead(int i)
+{
+	occupancy->remove(beadsX[i], beadsY[i]);
+	removePoint(total, beadsX[i], beadsY[i]);
+	lifted[i] = true;
+	contacts -= countContacts(i, beadsX[i], beadsY[i]);
+}
+
+// Puts a lifted bead down on a site along with its contacts
+//
+void combWalker::placeBead(int i, int x, int y)
+{
+	beadsX[i] = x;
+	beadsY[i] = y;
+	contacts += countContacts(i, x, y);
+	lifted[i] = false;
+	addPoint(total, x, y);
+	occupancy->add(x, y);
+}
+
+// Moves a bead and remembers where it was so the move can be undone
+//
+void combWalker::moveBead(int i, int x, int y)
+{
+	undoBead[undoLength] = i;
+	undoX[undoLength] = beadsX[i];
+	undoY[undoLength] = beadsY[i];
+	undoLength++;
+
+	liftBead(i);
+	placeBead(i, x, y);
+}
+
+// Moves the whole chain back so its centre of mass is near the origin.
+// This is O(N) but only happens after the chain has drifted a long
+// way.
+//
+void combWalker::recenter()
+{
+	int shiftX = (int)(total.sx / total.n), shiftY = (int)(total.sy / total.n);
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		beadsX[i] -= shiftX;
+		beadsY[i] -= shiftY;
+	}
+
+	rebuild();
+}
+
+// Returns a random number from 0 to n - 1 (xorshift64*)
+//
+int combWalker::random(int n)
+{
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+
+	return (int)(((randomState * 2685821657736338717ULL) >> 33) % n);
+}
+
+// Returns a uniform random number in [0, 1)
+//
+double combWalker::randomUniform()
+{
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+
+	return ((randomState * 2685821657736338717ULL) >> 11)
+		   * (1.0 / 9007199254740992.0);
+}
+
+// Below this point are all get functions
+int combWalker::getBeadCount()
+{
+	return beadCount;
+}
+
+int combWalker::getContacts()
+{
+	return contacts;
+}
+
+int combWalker::getBeadX(int index)
+{
+	return beadsX[index];
+}
+
+int combWalker::getBeadY(int index)
+{
+	return beadsY[index];
+}
+
+void combWalker::getShape(shape& result)
+{
+	calculateShape(total, result);
+}
+
+void combWalker::setConformation(const int* x, const int* y)
+{
+	for(int i = 0; i < beadCount; i++)
+	{
+		beadsX[i] = x[i];
+		beadsY[i] = y[i];
+	}
+
+	rebuild();
+}
+
+// Returns a seed for a walker's own generator, taken from rand so a
+// run is repeated exactly whenever rand is.
+//
+unsigned long long getWalkerSeed()
+{
+	unsigned long long seed = 0;
+
+	for(int k = 0; k < 4; k++)
+	{
+		seed = (seed << 16) ^ (unsigned long long)rand();
+	}
+
+	return seed;
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      combwalker.h                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the combWalker class.                          *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+#include "moments.h"
+#include "occupancy.h"
+
+// Defines how often a move is a pivot rather than a local move, as one
+// move in this many.
+const int PIVOT_FRACTION = 10;
+
+// A self-avoiding H-Comb on the lattice with an attraction between
+// beads. Every pair of beads on neighbouring sites that are not bonded
+// is a contact, worth an energy of -1. It starts laid out straight in
+// the shape of an H, with no contacts at all.
+//
+// A move is applied as soon as it is proposed, with the contacts, the
+// gyration moments and the occupancy kept up to date for each bead
+// that moves, and is then either kept with accept or taken back with
+// undo. The moves are the end flips, corner flips and crankshafts
+// dynamics uses, pull moves along the arms (Lesh, Mitzenmacher and
+// Whitesides), and pivots. A pull moves a bead with two bonds to a
+// free site diagonal to it and next to one of its neighbours, or an
+// end two sites away, and the beads behind it follow two sites up the
+// chain until the chain is whole again. A pivot turns or reflects
+// everything on one side of a bond about the bead at the other end.
+// Without pivots the branch points could never move: no free site is
+// ever next to all three of a branch point's neighbours.
+//
+// Every proposal is as likely as its reverse, and every walker has a
+// random number generator of its own so walkers can run on separate
+// threads.
+class combWalker
+{
+private:
+	int beadsX[MAX_BEADS];
+	int beadsY[MAX_BEADS];
+	int bonds[MAX_BEADS][3];
+	int bondCount[MAX_BEADS];
+	bool lifted[MAX_BEADS];
+	int beadCount;
+	int contacts;
+	occupancyGrid* occupancy;
+	moments total;
+	unsigned long long randomState;
+
+	// Beads moved by the move being tried and where they came from
+	int undoBead[MAX_BEADS];
+	int undoX[MAX_BEADS];
+	int undoY[MAX_BEADS];
+	int undoLength;
+
+	// Scratch space for the beads a pivot turns
+	int branch[MAX_BEADS];
+
+	void layoutStraight();
+	void rebuild();
+	bool tryEndFlip(int i);
+	bool tryCornerFlip(int i);
+	bool tryCrankshaft(int i);
+	bool tryPull(int i);
+	bool tryEndPull(int i);
+	bool followPull(int first, int from, int twoAheadX, int twoAheadY,
+					int oneAheadX, int oneAheadY);
+	bool tryPivot(int i);
+	bool isFree(int x, int y);
+	int countContacts(int i, int x, int y);
+	void liftBead(int i);
+	void placeBead(int i, int x, int y);
+	void moveBead(int i, int x, int y);
+	void recenter();
+
+public:
+	// Constructor and destructor
+	combWalker(sample* s, unsigned long long seed);
+	~combWalker(void);
+
+	// Functionality
+	bool tryMove();
+	void accept();
+	void undo();
+	int random(int n);
+	double randomUniform();
+
+	// Gets and sets
+	int getBeadCount();
+	int getContacts();
+	int getBeadX(int index);
+	int getBeadY(int index);
+	void getShape(shape& result);
+	void setConformation(const int* x, const int* y);
+};
+
+// Functionality
+unsigned long long getWalkerSeed();
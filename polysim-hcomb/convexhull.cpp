@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      convexhull.cpp                                      *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the convexHull class.      *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include "convexhull.h"
+
+// Constructor for a convex hull.
+//
+convexHull::convexHull(void)
+{
+	lowerCount = 0;
+	upperCount = 0;
+}
+
+// Destructor for a convex hull.
+//
+convexHull::~convexHull(void)
+{
+
+}
+
+// Pushes a point onto one of the monotone chains, first dropping
+// every point that would stop the chain from turning the right way.
+// The lower chain must turn left and the upper chain right, collinear
+// points are dropped from both.
+//
+void convexHull::buildChain(coordinate chain[], int& count, int x, int y,
+							bool isLower)
+{
+	while(count >= 2)
+	{
+		coordinate a = chain[count - 2], b = chain[count - 1];
+		long long cross = (long long)(b.x - a.x) * (y - a.y)
+			              - (long long)(b.y - a.y) * (x - a.x);
+
+		if((isLower && cross > 0) || (!isLower && cross < 0))
+		{
+			break;
+		}
+
+		count--;
+	}
+
+	chain[count].x = x;
+	chain[count].y = y;
+	count++;
+}
+
+// Works out the hull of a sample and stores its area and perimeter
+// in the sample.
+//
+void convexHull::calculate(sample* s)
+{
+	int beads = s->getBeadCount();
+	int minX = s->getBeadX(0), maxX = s->getBeadX(0);
+	double area = 0.0, perimeter = 0.0;
+
+	for(int i = 1; i < beads; i++)
+	{
+		if(s->getBeadX(i) < minX)
+		{
+			minX = s->getBeadX(i);
+		}
+
+		if(s->getBeadX(i) > maxX)
+		{
+			maxX = s->getBeadX(i);
+		}
+	}
+
+	int span = maxX - minX + 1;
+
+	// Keep the extremes of every column. A column nobody visited is
+	// left with low > high and skipped below.
+	for(int c = 0; c < span; c++)
+	{
+		columnLow[c] = 1;
+		columnHigh[c] = 0;
+	}
+
+	for(int i = 0; i < beads; i++)
+	{
+		int c = s->getBeadX(i) - minX, y = s->getBeadY(i);
+
+		if(columnLow[c] > columnHigh[c])
+		{
+			columnLow[c] = y;
+			columnHigh[c] = y;
+		}
+		else if(y < columnLow[c])
+		{
+			columnLow[c] = y;
+		}
+		else if(y > columnHigh[c])
+		{
+			columnHigh[c] = y;
+		}
+	}
+
+	// Columns are already in order so the chains need no sort
+	lowerCount = 0;
+	upperCount = 0;
+
+	for(int c = 0; c < span; c++)
+	{
+		if(columnLow[c] <= columnHigh[c])
+		{
+			buildChain(lower, lowerCount, c + minX, columnLow[c], true);
+			buildChain(upper, upperCount, c + minX, columnHigh[c], false);
+		}
+	}
+
+	// Walk the hull counter clockwise, along the lower chain and
+	// back along the upper one.
+	coordinate previous = upper[0];
+
+	for(int i = 0; i < lowerCount + upperCount; i++)
+	{
+		coordinate current = (i < lowerCount) ? lower[i]
+			                 : upper[upperCount - 1 - (i - lowerCount)];
+		double dx = current.x - previous.x, dy = current.y - previous.y;
+
+		area += (double)previous.x * current.y
+			    - (double)current.x * previous.y;
+		perimeter += sqrt(dx * dx + dy * dy);
+		previous = current;
+	}
+
+	s->setHullArea(fabs(area) / 2.0);
+	s->setHullPerimeter(perimeter);
+}
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      convexhull.h                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the convexHull class.                          *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+
+// Finds the convex hull area and perimeter of a sample. Lattice
+// coordinates are bounded integers, so instead of sorting the beads
+// only the lowest and highest bead of every column is kept and the
+// monotone chain is run over those in column order, which is
+// O(N + span).
+class convexHull
+{
+private:
+	int columnLow[MAX_BEADS];
+	int columnHigh[MAX_BEADS];
+	coordinate lower[MAX_BEADS];
+	coordinate upper[MAX_BEADS];
+	int lowerCount, upperCount;
+
+	void buildChain(coordinate chain[], int& count, int x, int y,
+		            bool isLower);
+
+public:
+	// Constructor and destructor
+	convexHull(void);
+	~convexHull(void);
+
+	// Functionality
+	void calculate(sample* s);
+};
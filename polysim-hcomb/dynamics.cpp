@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      dynamics.cpp                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the dynamics class.        *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "dynamics.h"
+#include "combwalker.h"
+
+// Defines how far the centre of mass may drift before the whole
+// chain is moved back to the origin, keeping the moment sums small.
+const int RECENTER_DISTANCE = 4096;
+
+// Lattice directions in the order growArm uses them
+const int DIRECTION_X[4] = {0, 0, 1, -1};
+const int DIRECTION_Y[4] = {1, -1, 0, 0};
+
+// Constructor for a dynamics run. The conformation and the bonds
+// are copied out of the sample so the sample itself is left as it is.
+// With excluded volume the run is handed to a combWalker instead,
+// which starts from a straight H since a grown sample overlaps itself.
+//
+dynamics::dynamics(sample* s, bool excludedVolume)
+{
+	beadCount = s->getBeadCount();
+	attemptedMoves = 0;
+	acceptedMoves = 0;
+	recordInterval = 1;
+	seriesRadiusofGyration = 0;
+	seriesAsphericity = 0;
+	seriesLength = 0;
+	walker = 0;
+
+	clearMoments(total);
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		beadsX[i] = s->getBeadX(i);
+		beadsY[i] = s->getBeadY(i);
+		bondCount[i] = 0;
+		addPoint(total, beadsX[i], beadsY[i]);
+	}
+
+	for(int i = 1; i < beadCount; i++)
+	{
+		int j = s->getBondedBead(i);
+
+		bonds[i][bondCount[i]++] = j;
+		bonds[j][bondCount[j]++] = i;
+	}
+
+	if(excludedVolume)
+	{
+		walker = new combWalker(s, getWalkerSeed());
+	}
+}
+
+// Destructor for a dynamics run.
+//
+dynamics::~dynamics(void)
+{
+	delete walker;
+	delete [] seriesRadiusofGyration;
+	delete [] seriesAsphericity;
+}
+
+// Attempts the given number of moves, recording s^2 and A every
+// interval moves. The interval is stretched if the series would
+// otherwise grow past MAX_SERIES points.
+//
+void dynamics::run(long long moves, long long interval)
+{
+	long long untilRecord;
+
+	if(interval < 1)
+	{
+		interval = 1;
+	}
+
+	if(moves / interval > MAX_SERIES)
+	{
+		interval = (moves + MAX_SERIES - 1) / MAX_SERIES;
+	}
+
+	recordInterval = interval;
+
+	delete [] seriesRadiusofGyration;
+	delete [] seriesAsphericity;
+	seriesLength = 0;
+	seriesRadiusofGyration = new double[(int)(moves / interval) + 1];
+	seriesAsphericity = new double[(int)(moves / interval) + 1];
+
+	record();
+	untilRecord = interval;
+
+	for(long long t = 0; t < moves; t++)
+	{
+		tryMove();
+
+		untilRecord--;
+
+		if(untilRecord == 0)
+		{
+			record();
+			untilRecord = interval;
+		}
+	}
+}
+
+// Picks a bead at random and tries a move that suits it. Ends can
+// only flip, beads with two bonds try a corner flip or a crankshaft
+// with equal chance, and branch points try a branch move. With
+// excluded volume the walker proposes the move, and every move it can
+// make is kept since there is no energy.
+//
+bool dynamics::tryMove()
+{
+	int i;
+	bool moved = false;
+
+	attemptedMoves++;
+
+	if(walker != 0)
+	{
+		if(walker->tryMove())
+		{
+			walker->accept();
+			acceptedMoves++;
+			return true;
+		}
+
+		return false;
+	}
+
+	i = rand() % beadCount;
+
+	switch(bondCount[i])
+	{
+	case 1:
+		moved = tryEndFlip(i);
+		break;
+
+	case 2:
+		if(rand() % 2 == 0)
+		{
+			moved = tryCornerFlip(i);
+		}
+		else
+		{
+			moved = tryCrankshaft(i);
+		}
+		break;
+
+	case 3:
+		moved = tryBranchMove(i);
+		break;
+
+	default:;
+	}
+
+	if(moved)
+	{
+		acceptedMoves++;
+	}
+
+	return moved;
+}
+
+// Moves an end bead to one of the four sites around the bead it is
+// bonded to.
+//
+bool dynamics::tryEndFlip(int i)
+{
+	int n = bonds[i][0], d = rand() % 4;
+	int x = beadsX[n] + DIRECTION_X[d], y = beadsY[n] + DIRECTION_Y[d];
+
+	if(x == beadsX[i] && y == beadsY[i])
+	{
+		return false;
+	}
+
+	moveBead(i, x, y);
+
+	return true;
+}
+
+// Flips a corner bead across the diagonal of its two neighbours.
+// When the chain folds back on itself both neighbours share a site
+// and the bead may go to any site around it instead.
+//
+bool dynamics::tryCornerFlip(int i)
+{
+	int a = bonds[i][0], b = bonds[i][1];
+	int x, y;
+
+	if(beadsX[a] == beadsX[b] && beadsY[a] == beadsY[b])
+	{
+		int d = rand() % 4;
+		x = beadsX[a] + DIRECTION_X[d];
+		y = beadsY[a] + DIRECTION_Y[d];
+	}
+	else if(abs(beadsX[a] - beadsX[b]) == 1
+		    && abs(beadsY[a] - beadsY[b]) == 1)
+	{
+		x = beadsX[a] + beadsX[b] - beadsX[i];
+		y = beadsY[a] + beadsY[b] - beadsY[i];
+	}
+	else
+	{
+		return false;
+	}
+
+	if(x == beadsX[i] && y == beadsY[i])
+	{
+		return false;
+	}
+
+	moveBead(i, x, y);
+
+	return true;
+}
+
+// Turns a U made of a-i-j-b over to the other side of the a-b bond.
+//
+bool dynamics::tryCrankshaft(int i)
+{
+	int j = bonds[i][rand() % 2];
+
+	if(bondCount[j] != 2)
+	{
+		return false;
+	}
+
+	int a = (bonds[i][0] == j) ? bonds[i][1] : bonds[i][0];
+	int b = (bonds[j][0] == i) ? bonds[j][1] : bonds[j][0];
+
+	// i and j must stick out from a and b the same way, across the
+	// a-b bond
+	int dx = beadsX[i] - beadsX[a], dy = beadsY[i] - beadsY[a];
+	int ex = beadsX[j] - beadsX[i], ey = beadsY[j] - beadsY[i];
+
+	if(beadsX[j] - beadsX[b] != dx || beadsY[j] - beadsY[b] != dy
+		|| dx * ex + dy * ey != 0)
+	{
+		return false;
+	}
+
+	int ix = beadsX[a] - dx, iy = beadsY[a] - dy;
+	int jx = beadsX[b] - dx, jy = beadsY[b] - dy;
+
+	moveBead(i, ix, iy);
+	moveBead(j, jx, jy);
+
+	return true;
+}
+
+// Moves a branch point to a site next to all three of its neighbours.
+// That is only possible once two of them share a site, but without it
+// the branch points would never move and the separation of the two
+// branch points, which no other move changes, would stay at whatever
+// the grown sample started with.
+//
+bool dynamics::tryBranchMove(int i)
+{
+	int n = bonds[i][0], d = rand() % 4;
+	int x = beadsX[n] + DIRECTION_X[d], y = beadsY[n] + DIRECTION_Y[d];
+
+	if(x == beadsX[i] && y == beadsY[i])
+	{
+		return false;
+	}
+
+	for(int k = 1; k < 3; k++)
+	{
+		int m = bonds[i][k];
+
+		if(abs(beadsX[m] - x) + abs(beadsY[m] - y) != 1)
+		{
+			return false;
+		}
+	}
+
+	moveBead(i, x, y);
+
+	return true;
+}
+
+// Moves a bead and updates the moments
+//
+void dynamics::moveBead(int i, int x, int y)
+{
+	removePoint(total, beadsX[i], beadsY[i]);
+	addPoint(total, x, y);
+
+	beadsX[i] = x;
+	beadsY[i] = y;
+
+	if(total.sx > (long long)RECENTER_DISTANCE * total.n
+		|| total.sx < -(long long)RECENTER_DISTANCE * total.n
+		|| total.sy > (long long)RECENTER_DISTANCE * total.n
+		|| total.sy < -(long long)RECENTER_DISTANCE * total.n)
+	{
+		recenter();
+	}
+}
+
+// Moves the whole chain back so its centre of mass is near the origin.
+// This is O(N) but only happens after the chain has drifted a long
+// way.
+//
+void dynamics::recenter()
+{
+	int shiftX = (int)(total.sx / total.n), shiftY = (int)(total.sy / total.n);
+
+	clearMoments(total);
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		beadsX[i] -= shiftX;
+		beadsY[i] -= shiftY;
+		addPoint(total, beadsX[i], beadsY[i]);
+	}
+}
+
+// Adds the current s^2 and A to the time series
+//
+void dynamics::record()
+{
+	shape result;
+
+	if(walker != 0)
+	{
+		walker->getShape(result);
+	}
+	else
+	{
+		calculateShape(total, result);
+	}
+
+	seriesRadiusofGyration[seriesLength] = result.radiusofGyration;
+	seriesAsphericity[seriesLength] = result.asphericity;
+	seriesLength++;
+}
+
+// Below this point are all get functions
+int dynamics::getBeadCount()
+{
+	return beadCount;
+}
+
+long long dynamics::getAttemptedMoves()
+{
+	return attemptedMoves;
+}
+
+long long dynamics::getAcceptedMoves()
+{
+	return acceptedMoves;
+}
+
+long long dynamics::getRecordInterval()
+{
+	return recordInterval;
+}
+
+int dynamics::getSeriesLength()
+{
+	return seriesLength;
+}
+
+const double* dynamics::getRadiusofGyrationSeries()
+{
+	return seriesRadiusofGyration;
+}
+
+const double* dynamics::getAsphericitySeries()
+{
+	return seriesAsphericity;
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      dynamics.h                                          *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the dynamics class.                            *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+#include "moments.h"
+#include "combwalker.h"
+
+// Defines the maximum number of points kept in a time series.
+const int MAX_SERIES = 4194304;
+
+// Evolves a grown sample with local lattice moves: end flips, corner
+// flips, crankshafts and branch point moves. Every move is chosen
+// with a symmetric probability and always accepted, so the athermal
+// ensemble is kept. The gyration moments are updated by O(1) per
+// accepted move and s^2 and A are recorded every interval moves.
+//
+// With excluded volume the branch point move can never be made, since
+// no free site is next to all three neighbours, so local moves alone
+// would leave the branch points where they start. Those runs use a
+// combWalker with no contact energy instead, which starts from a
+// straight H and adds pulls and pivots to the local moves. A pivot
+// is not a physical motion, so the times in such a run count moves
+// rather than a real dynamics.
+class dynamics
+{
+private:
+	int beadsX[MAX_BEADS];
+	int beadsY[MAX_BEADS];
+	int bonds[MAX_BEADS][3];
+	int bondCount[MAX_BEADS];
+	int beadCount;
+	combWalker* walker;
+	moments total;
+	long long attemptedMoves, acceptedMoves, recordInterval;
+	double* seriesRadiusofGyration;
+	double* seriesAsphericity;
+	int seriesLength;
+
+	bool tryMove();
+	bool tryEndFlip(int i);
+	bool tryCornerFlip(int i);
+	bool tryCrankshaft(int i);
+	bool tryBranchMove(int i);
+	void moveBead(int i, int x, int y);
+	void recenter();
+	void record();
+
+public:
+	// Constructor and destructor
+	dynamics(sample* s, bool excludedVolume);
+	~dynamics(void);
+
+	// Functionality
+	void run(long long moves, long long interval);
+
+	// Gets and sets
+	int getBeadCount();
+	long long getAttemptedMoves();
+	long long getAcceptedMoves();
+	long long getRecordInterval();
+	int getSeriesLength();
+	const double* getRadiusofGyrationSeries();
+	const double* getAsphericitySeries();
+};
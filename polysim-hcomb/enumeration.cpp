@@ -0,0 +1,361 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      enumeration.cpp                                     *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the exactEnumeration       *//
+//*  class. Each thread keeps its sums to itself and only adds them *//
+//*  to the totals once a task is done.                             *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <math.h>
+#include "enumeration.h"
+
+// Step directions, in the order rand() % 4 + 1 picks them in growArm
+const int NORTH = 0;
+const int SOUTH = 1;
+const int EAST = 2;
+const int WEST = 3;
+
+// Constructor for an exact enumeration of the combs of beadCount beads.
+//
+exactEnumeration::exactEnumeration(int beadCount)
+{
+	if(beadCount < 2)
+	{
+		beadCount = 2;
+	}
+	else if(beadCount > MAX_ENUMERATION_BEADS)
+	{
+		beadCount = MAX_ENUMERATION_BEADS;
+	}
+
+	this->beadCount = beadCount;
+	stepCount = beadCount - 1;
+
+	// The arm every step grows, as addBeads takes them
+	int armLength = stepCount / 5;
+
+	starSteps = stepCount - (armLength * 2);
+
+	for(int step = 0; step < stepCount; step++)
+	{
+		if(step < starSteps)
+		{
+			stepArm[step] = step % 3;
+		}
+		else
+		{
+			stepArm[step] = 3 + (step - starSteps) % 2;
+		}
+	}
+
+	splitDepth = (stepCount < ENUMERATION_SPLIT_DEPTH) 
+				 ? stepCount : ENUMERATION_SPLIT_DEPTH;
+	tasks = NULL;
+	taskCount = 0;
+	threadCount = 0;
+	nextTask = 0;
+	conformations = 0;
+
+	for(int q = 0; q < 4; q++)
+	{
+		sums[q] = 0.0;
+		squares[q] = 0.0;
+	}
+}
+
+// Destructor for an exact enumeration.
+//
+exactEnumeration::~exactEnumeration(void)
+{
+	delete [] tasks;
+}
+
+// Goes through every walk on as many threads as there are processors.
+//
+void exactEnumeration::run()
+{
+	unsigned char prefix[ENUMERATION_SPLIT_DEPTH];
+
+	// First count the tasks, then store them
+	taskCount = 0;
+	collectTasks(NULL, 0, false);
+	tasks = new unsigned char[taskCount * splitDepth];
+	taskCount = 0;
+	collectTasks(prefix, 0, false);
+
+	threadCount = getWorkerCount(taskCount);
+
+	void* args[MAX_THREADS];
+
+	for(int t = 0; t < threadCount; t++)
+	{
+		args[t] = this;
+	}
+
+	runThreads(threadCount, workerEntry, args);
+}
+
+// Where every worker thread starts.
+//
+void exactEnumeration::workerEntry(void* args)
+{
+	((exactEnumeration*)args)->work();
+}
+
+// Takes tasks until there are none left. Each task is started from
+// scratch by taking its first steps again.
+//
+void exactEnumeration::work()
+{
+	enumerationState* state = new enumerationState;
+
+	while(true)
+	{
+		long task = atomicAdd(&nextTask, 1) - 1;
+
+		if(task >= taskCount)
+		{
+			break;
+		}
+
+		const unsigned char* prefix = tasks + task * splitDepth;
+		bool turned = false;
+
+		for(int a = 0; a < 5; a++)
+		{
+			state->headX[a] = 0;
+			state->headY[a] = 0;
+		}
+
+		clearMoments(state->total[0]);
+		addPoint(state->total[0], 0, 0);
+		state->conformations = 0;
+
+		for(int q = 0; q < 4; q++)
+		{
+			state->sums[q] = 0.0;
+			state->squares[q] = 0.0;
+		}
+
+		for(int step = 0; step < splitDepth; step++)
+		{
+			placeStep(*state, step, prefix[step]);
+			turned = turned || prefix[step] == EAST;
+		}
+
+		descend(*state, splitDepth, turned);
+
+		totalsLock.lock();
+
+		for(int q = 0; q < 4; q++)
+		{
+			sums[q] += state->sums[q];
+			squares[q] += state->squares[q];
+		}
+
+		conformations += state->conformations;
+
+		totalsLock.unlock();
+	}
+
+	delete state;
+}
+
+// Counts, or with somewhere to put them stores, the first splitDepth
+// steps of every walk that is visited. The first step is always North
+// and West is only allowed once the walk has turned East.
+//
+void exactEnumeration::collectTasks(unsigned char* prefix, int step, 
+									bool turned)
+{
+	if(step == splitDepth)
+	{
+		if(prefix != NULL)
+		{
+			for(int s = 0; s < splitDepth; s++)
+			{
+				tasks[taskCount * splitDepth + s] = prefix[s];
+			}
+		}
+
+		taskCount++;
+		return;
+	}
+
+	for(int direction = NORTH; direction <= WEST; direction++)
+	{
+		if((step == 0 && direction != NORTH) 
+			|| (!turned && direction == WEST))
+		{
+			continue;
+		}
+
+		if(prefix != NULL)
+		{
+			prefix[step] = (unsigned char)direction;
+		}
+
+		collectTasks(prefix, step + 1, turned || direction == EAST);
+	}
+}
+
+// Grows the bead of a step in a direction and works out the moments
+// with it from those of the step before.
+//
+void exactEnumeration::placeStep(enumerationState& state, int step, 
+								 int direction)
+{
+	int arm = stepArm[step];
+
+	// Arms 4 and 5 both start at the head of arm 3
+	if(step == starSteps)
+	{
+		state.headX[3] = state.headX[2];
+		state.headY[3] = state.headY[2];
+		state.headX[4] = state.headX[2];
+		state.headY[4] = state.headY[2];
+	}
+
+	switch(direction)
+	{
+	case NORTH:
+		state.headY[arm]++;
+		break;
+
+	case SOUTH:
+		state.headY[arm]--;
+		break;
+
+	case EAST:
+		state.headX[arm]++;
+		break;
+
+	default:
+		state.headX[arm]--;
+	}
+
+	state.total[step + 1] = state.total[step];
+	addPoint(state.total[step + 1], state.headX[arm], state.headY[arm]);
+}
+
+// Goes through every way the walk can carry on from a step, and adds
+// the shape of each finished walk to the sums with the number of walks
+// it stands for.
+//
+void exactEnumeration::descend(enumerationState& state, int step, 
+							   bool turned)
+{
+	if(step == stepCount)
+	{
+		// As calculateShape works it out, but with A written straight
+		// from the tensor, since this runs once for every walk
+		const moments& m = state.total[stepCount];
+		double weight = turned ? 8.0 : 4.0;
+		double n = (double)m.n;
+		double xcm = m.sx / n, ycm = m.sy / n;
+		double a = m.sxx / n - xcm * xcm;
+		double b = m.sxy / n - xcm * ycm;
+		double c = m.syy / n - ycm * ycm;
+		double split = (a - c) * (a - c) + 4 * (b * b);
+		double factor = (1.0 / 2) * sqrt(split);
+		double trace = a + c;
+
+		double values[4] = {(trace / 2) + factor, (trace / 2) - factor, 
+							trace, split / (trace * trace)};
+
+		for(int q = 0; q < 4; q++)
+		{
+			state.sums[q] += weight * values[q];
+			state.squares[q] += weight * values[q] * values[q];
+		}
+
+		state.conformations += turned ? 8 : 4;
+		return;
+	}
+
+	int arm = stepArm[step];
+	int headX, headY;
+
+	// The head the step grows from, after arms 4 and 5 are grafted
+	if(step == starSteps)
+	{
+		headX = state.headX[2];
+		headY = state.headY[2];
+	}
+	else
+	{
+		headX = state.headX[arm];
+		headY = state.headY[arm];
+	}
+
+	for(int direction = NORTH; direction <= WEST; direction++)
+	{
+		if(!turned && direction == WEST)
+		{
+			continue;
+		}
+
+		placeStep(state, step, direction);
+		descend(state, step + 1, turned || direction == EAST);
+
+		state.headX[arm] = headX;
+		state.headY[arm] = headY;
+	}
+}
+
+// Below this point are all get functions
+//
+int exactEnumeration::getBeadCount()
+{
+	return beadCount;
+}
+
+int exactEnumeration::getThreadCount()
+{
+	return threadCount;
+}
+
+int exactEnumeration::getTaskCount()
+{
+	return taskCount;
+}
+
+long long exactEnumeration::getConformations()
+{
+	return conformations;
+}
+
+void exactEnumeration::getAverages(shape& result)
+{
+	double n = (double)conformations;
+
+	result.lamda1 = sums[0] / n;
+	result.lamda2 = sums[1] / n;
+	result.radiusofGyration = sums[2] / n;
+	result.asphericity = sums[3] / n;
+}
+
+// The spread of each quantity over all walks, not an error on the
+// averages, which are exact.
+//
+void exactEnumeration::getDeviations(shape& result)
+{
+	double n = (double)conformations;
+	double deviation[4];
+
+	for(int q = 0; q < 4; q++)
+	{
+		double mean = sums[q] / n;
+		double variance = squares[q] / n - mean * mean;
+
+		deviation[q] = (variance > 0.0) ? sqrt(variance) : 0.0;
+	}
+
+	result.lamda1 = deviation[0];
+	result.lamda2 = deviation[1];
+	result.radiusofGyration = deviation[2];
+	result.asphericity = deviation[3];
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      enumeration.h                                       *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the exactEnumeration class.                    *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "moments.h"
+#include "threads.h"
+
+// Defines the most beads a comb can be enumerated with. 4^23 walks
+// would take days, this is only a guard against typing errors.
+const int MAX_ENUMERATION_BEADS = 24;
+
+// Defines how many steps are taken before the walks are handed out to
+// the threads. Every walk that starts the same way up to here is one
+// task.
+const int ENUMERATION_SPLIT_DEPTH = 8;
+
+// What one thread carries through the walks it enumerates
+struct enumerationState
+{
+	int headX[5];
+	int headY[5];
+	moments total[MAX_ENUMERATION_BEADS];
+	double sums[4];
+	double squares[4];
+	long long conformations;
+};
+
+// Works out the exact averages of lamda1, lamda2, s^2 and A over every
+// one of the 4^(N - 1) random walk H-Combs of N beads that addBeads can
+// grow, all equally likely. They are the values every sampling mode
+// should agree with for small combs.
+//
+// The walks are gone through depth first, one step at a time in the
+// order addBead takes the arms, with the moments of every step kept
+// on a stack so each step only adds one bead. The shape quantities
+// are the same for a walk turned or reflected about the origin, so
+// only walks whose first step is North, and whose first sideways step
+// is East, are visited: those that turn at all stand for eight walks,
+// those that never turn for four.
+//
+// The walks that share their first ENUMERATION_SPLIT_DEPTH steps form
+// one task. Threads take the next task from a shared counter as they
+// finish the last, so none sits idle while there is work left.
+class exactEnumeration
+{
+private:
+	int beadCount, stepCount, starSteps, splitDepth;
+	int threadCount, taskCount;
+	int stepArm[MAX_ENUMERATION_BEADS];
+	unsigned char* tasks;
+	volatile long nextTask;
+	double sums[4], squares[4];
+	long long conformations;
+	threadLock totalsLock;
+
+	static void workerEntry(void* args);
+	void work();
+	void collectTasks(unsigned char* prefix, int step, bool turned);
+	void placeStep(enumerationState& state, int step, int direction);
+	void descend(enumerationState& state, int step, bool turned);
+
+public:
+	// Constructor and destructor
+	exactEnumeration(int beadCount);
+	~exactEnumeration(void);
+
+	// Functionality
+	void run();
+
+	// Gets and sets
+	int getBeadCount();
+	int getThreadCount();
+	int getTaskCount();
+	long long getConformations();
+	void getAverages(shape& result);
+	void getDeviations(shape& result);
+};
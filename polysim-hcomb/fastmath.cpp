@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      fastmath.cpp                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Sine and cosine together from one range reduction and two      *//
+//*  short polynomials, good to about one unit in the last place    *//
+//*  for the angles the growth code uses. The batch version works   *//
+//*  on two angles at a time with SSE2 when the compiler has it.    *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#if defined(__SSE2__) || defined(_M_X64) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FASTMATH_SSE2
+#include <emmintrin.h>
+#endif
+#include "fastmath.h"
+
+// 2 / pi and pi / 2 split in three so x - q * pi / 2 stays exact
+const double TWO_OVER_PI = 6.36619772367581382433E-1;
+const double PIO2_1 = 1.57079625129699707031E+00;
+const double PIO2_2 = 7.54978941586159635335E-08;
+const double PIO2_3 = 5.39030285815811905290E-15;
+
+// Polynomial coefficients for sin and cos on [-pi/4, pi/4]
+const double S1 = -1.66666666666666307295E-1;
+const double S2 = 8.33333333332211858878E-3;
+const double S3 = -1.98412698295895385996E-4;
+const double S4 = 2.75573136213857245213E-6;
+const double S5 = -2.50507477628578072866E-8;
+const double S6 = 1.58962301576546568060E-10;
+const double C1 = 4.16666666666665929218E-2;
+const double C2 = -1.38888888888730564116E-3;
+const double C3 = 2.48015872888517045348E-5;
+const double C4 = -2.75573141792967388112E-7;
+const double C5 = 2.08757008419747316778E-9;
+const double C6 = -1.13585365213876817300E-11;
+
+// Works out the sine and cosine of one angle
+//
+void fastSinCos(double x, double& sine, double& cosine)
+{
+	double t = x * TWO_OVER_PI;
+	int q = (int)(t < 0.0 ? t - 0.5 : t + 0.5);
+	double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+	double z = r * r;
+	double s = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4
+		       + z * (S5 + z * S6)))));
+	double c = 1.0 - 0.5 * z + z * z * (C1 + z * (C2 + z * (C3
+		       + z * (C4 + z * (C5 + z * C6)))));
+
+	// Turn the result round to the quadrant x was in
+	switch(q & 3)
+	{
+	case 0:
+		sine = s;
+		cosine = c;
+		break;
+
+	case 1:
+		sine = c;
+		cosine = -s;
+		break;
+
+	case 2:
+		sine = -s;
+		cosine = -c;
+		break;
+
+	default:
+		sine = -c;
+		cosine = s;
+	}
+}
+
+// Works out the sine and cosine of count angles
+//
+void fastSinCosBatch(const double* x, double* sine, double* cosine,
+					 int count)
+{
+	int i = 0;
+
+#ifdef FASTMATH_SSE2
+	const __m128d twoOverPi = _mm_set1_pd(TWO_OVER_PI);
+	const __m128d pio2a = _mm_set1_pd(PIO2_1);
+	const __m128d pio2b = _mm_set1_pd(PIO2_2);
+	const __m128d pio2c = _mm_set1_pd(PIO2_3);
+	const __m128d half = _mm_set1_pd(0.5);
+	const __m128d one = _mm_set1_pd(1.0);
+	const __m128d signBit = _mm_set1_pd(-0.0);
+	const __m128i one32 = _mm_set1_epi32(1);
+	const __m128i two32 = _mm_set1_epi32(2);
+
+	for(; i + 2 <= count; i += 2)
+	{
+		__m128d v = _mm_loadu_pd(x + i);
+
+		// Nearest quadrant, the default rounding mode rounds to even
+		__m128i q = _mm_cvtpd_epi32(_mm_mul_pd(v, twoOverPi));
+		__m128d qd = _mm_cvtepi32_pd(q);
+		__m128d r = _mm_sub_pd(v, _mm_mul_pd(qd, pio2a));
+		r = _mm_sub_pd(r, _mm_mul_pd(qd, pio2b));
+		r = _mm_sub_pd(r, _mm_mul_pd(qd, pio2c));
+
+		__m128d z = _mm_mul_pd(r, r);
+		__m128d ps = _mm_set1_pd(S6);
+		ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(S5));
+		ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(S4));
+		ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(S3));
+		ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(S2));
+		ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(S1));
+		__m128d s = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, z), ps));
+
+		__m128d pc = _mm_set1_pd(C6);
+		pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(C5));
+		pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(C4));
+		pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(C3));
+		pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(C2));
+		pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(C1));
+		__m128d c = _mm_add_pd(_mm_sub_pd(one, _mm_mul_pd(half, z)),
+			                   _mm_mul_pd(_mm_mul_pd(z, z), pc));
+
+		// Spread each 32 bit quadrant over its 64 bit lane to get
+		// full width masks: odd quadrants swap sin and cos, quadrants
+		// 2 and 3 negate sin, quadrants 1 and 2 negate cos.
+		__m128i q64 = _mm_shuffle_epi32(q, _MM_SHUFFLE(1, 1, 0, 0));
+		__m128d swap = _mm_castsi128_pd(_mm_cmpeq_epi32(
+			_mm_and_si128(q64, one32), one32));
+		__m128d negS = _mm_castsi128_pd(_mm_cmpeq_epi32(
+			_mm_and_si128(q64, two32), two32));
+		__m128d negC = _mm_castsi128_pd(_mm_cmpeq_epi32(
+			_mm_and_si128(_mm_add_epi32(q64, one32), two32), two32));
+
+		__m128d outS = _mm_or_pd(_mm_and_pd(swap, c),
+			                     _mm_andnot_pd(swap, s));
+		__m128d outC = _mm_or_pd(_mm_and_pd(swap, s),
+			                     _mm_andnot_pd(swap, c));
+
+		outS = _mm_xor_pd(outS, _mm_and_pd(negS, signBit));
+		outC = _mm_xor_pd(outC, _mm_and_pd(negC, signBit));
+
+		_mm_storeu_pd(sine + i, outS);
+		_mm_storeu_pd(cosine + i, outC);
+	}
+#endif
+
+	// Whatever is left over, or everything without SSE2
+	for(; i < count; i++)
+	{
+		fastSinCos(x[i], sine[i], cosine[i]);
+	}
+}
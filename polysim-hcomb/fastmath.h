@@ -0,0 +1,14 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      fastmath.h                                          *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the fast trig functions.                       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Functionality
+void fastSinCos(double x, double& sine, double& cosine);
+void fastSinCosBatch(const double* x, double* sine, double* cosine,
+					 int count);
@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      fft.cpp                                             *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the fft classes. A small   *//
+//*  radix-2 transform is bundled so the program has no required    *//
+//*  dependencies. Defining USE_FFTW switches the 2D transform over *//
+//*  to FFTW when it is installed.                                  *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <math.h>
+#ifdef USE_FFTW
+#include <fftw3.h>
+#endif
+#include "fft.h"
+
+const double PI = 3.14159265358979323846;
+
+// Returns the smallest power of two that is not less than n
+//
+int nextPowerOfTwo(int n)
+{
+	int p = 1;
+
+	while(p < n)
+	{
+		p = p * 2;
+	}
+
+	return p;
+}
+
+// Constructor for a 1D transform. The twiddle factors and the
+// bit reversed ordering are worked out once here so every call
+// to transform only does the butterflies.
+//
+fft1D::fft1D(int size)
+{
+	int bits = 0;
+
+	this->size = size;
+	twiddleRe = new double[size / 2 + 1];
+	twiddleIm = new double[size / 2 + 1];
+	reversed = new int[size];
+
+	for(int i = 0; i < size / 2; i++)
+	{
+		twiddleRe[i] = cos(-2.0 * PI * i / size);
+		twiddleIm[i] = sin(-2.0 * PI * i / size);
+	}
+
+	while((1 << bits) < size)
+	{
+		bits++;
+	}
+
+	for(int i = 0; i < size; i++)
+	{
+		int r = 0;
+
+		for(int b = 0; b < bits; b++)
+		{
+			if(i & (1 << b))
+			{
+				r |= 1 << (bits - 1 - b);
+			}
+		}
+
+		reversed[i] = r;
+	}
+}
+
+// Destructor for a 1D transform.
+//
+fft1D::~fft1D(void)
+{
+	delete [] twiddleRe;
+	delete [] twiddleIm;
+	delete [] reversed;
+}
+
+// Transforms size complex values in place.
+//
+void fft1D::transform(double* data)
+{
+	// Put the data in bit reversed order
+	for(int i = 0; i < size; i++)
+	{
+		int j = reversed[i];
+
+		if(j > i)
+		{
+			double re = data[2 * i], im = data[2 * i + 1];
+			data[2 * i] = data[2 * j];
+			data[2 * i + 1] = data[2 * j + 1];
+			data[2 * j] = re;
+			data[2 * j + 1] = im;
+		}
+	}
+
+	// Butterflies
+	for(int len = 2; len <= size; len = len * 2)
+	{
+		int half = len / 2, step = size / len;
+
+		for(int start = 0; start < size; start += len)
+		{
+			for(int k = 0; k < half; k++)
+			{
+				double wr = twiddleRe[k * step], wi = twiddleIm[k * step];
+				double* a = data + 2 * (start + k);
+				double* b = data + 2 * (start + k + half);
+				double tr = wr * b[0] - wi * b[1];
+				double ti = wr * b[1] + wi * b[0];
+
+				b[0] = a[0] - tr;
+				b[1] = a[1] - ti;
+				a[0] = a[0] + tr;
+				a[1] = a[1] + ti;
+			}
+		}
+	}
+}
+
+int fft1D::getSize()
+{
+	return size;
+}
+
+// Constructor for a 2D transform. FFTW plans must not be created
+// from several threads at once, so make every fft2D before starting
+// any workers.
+//
+fft2D::fft2D(int size)
+{
+	this->size = size;
+	rows = 0;
+	column = 0;
+	plan = 0;
+
+#ifdef USE_FFTW
+	fftw_complex* scratch = fftw_alloc_complex(size * size);
+	plan = fftw_plan_dft_2d(size, size, scratch, scratch,
+		                    FFTW_FORWARD, FFTW_MEASURE);
+	fftw_free(scratch);
+#else
+	rows = new fft1D(size);
+	column = new double[2 * size];
+#endif
+}
+
+// Destructor for a 2D transform.
+//
+fft2D::~fft2D(void)
+{
+#ifdef USE_FFTW
+	fftw_destroy_plan((fftw_plan)plan);
+#endif
+	delete rows;
+	delete [] column;
+}
+
+// Transforms a size x size grid in place. The grid is stored row
+// by row and must come from newGrid.
+//
+void fft2D::transform(double* data)
+{
+#ifdef USE_FFTW
+	fftw_execute_dft((fftw_plan)plan, (fftw_complex*)data,
+		             (fftw_complex*)data);
+#else
+	// Transform every row
+	for(int y = 0; y < size; y++)
+	{
+		rows->transform(data + 2 * y * size);
+	}
+
+	// Transform every column through a contiguous copy
+	for(int x = 0; x < size; x++)
+	{
+		for(int y = 0; y < size; y++)
+		{
+			column[2 * y] = data[2 * (y * size + x)];
+			column[2 * y + 1] = data[2 * (y * size + x) + 1];
+		}
+
+		rows->transform(column);
+
+		for(int y = 0; y < size; y++)
+		{
+			data[2 * (y * size + x)] = column[2 * y];
+			data[2 * (y * size + x) + 1] = column[2 * y + 1];
+		}
+	}
+#endif
+}
+
+// Makes a grid for transform. With FFTW the grid has to be aligned
+// the same way as the one the plan was made on, which plain new does
+// not promise, so it comes from FFTW's own allocator.
+//
+double* fft2D::newGrid()
+{
+#ifdef USE_FFTW
+	return (double*)fftw_alloc_complex(size * size);
+#else
+	return new double[2 * size * size];
+#endif
+}
+
+// Frees a grid made by newGrid.
+//
+void fft2D::deleteGrid(double* grid)
+{
+#ifdef USE_FFTW
+	fftw_free(grid);
+#else
+	delete [] grid;
+#endif
+}
+
+int fft2D::getSize()
+{
+	return size;
+}
+
+// Works out the autocorrelation of a series through the power
+// spectrum instead of the O(n^2) lag sum. The series is padded to
+// twice its length so the circular transform does not wrap around.
+// The power spectrum of a real series is real and even, so a second
+// forward transform gives the inverse up to a factor of size.
+//
+void calculateAutocorrelation(const double* series, int length,
+							  double* result, int maxLag)
+{
+	int size = nextPowerOfTwo(2 * length);
+	double mean = 0.0;
+	double* data = new double[2 * size];
+	fft1D f(size);
+
+	for(int i = 0; i < length; i++)
+	{
+		mean += series[i];
+	}
+
+	mean = mean / length;
+
+	for(int i = 0; i < size; i++)
+	{
+		data[2 * i] = (i < length) ? series[i] - mean : 0.0;
+		data[2 * i + 1] = 0.0;
+	}
+
+	f.transform(data);
+
+	for(int i = 0; i < size; i++)
+	{
+		data[2 * i] = data[2 * i] * data[2 * i]
+			          + data[2 * i + 1] * data[2 * i + 1];
+		data[2 * i + 1] = 0.0;
+	}
+
+	f.transform(data);
+
+	// Each lag is averaged over the pairs it really has
+	double variance = data[0] / size / length;
+
+	for(int t = 0; t < maxLag; t++)
+	{
+		if(t < length && variance > 0.0)
+		{
+			result[t] = data[2 * t] / size / (length - t) / variance;
+		}
+		else
+		{
+			result[t] = 0.0;
+		}
+	}
+
+	delete [] data;
+}
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      fft.h                                               *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the fft classes.                               *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Complex data is stored interleaved as (re, im) pairs of doubles so
+// the same buffers can be handed straight to FFTW when USE_FFTW is
+// defined at build time.
+
+// A forward transform of a one dimensional power of two length
+class fft1D
+{
+private:
+	int size;
+	double* twiddleRe;
+	double* twiddleIm;
+	int* reversed;
+
+public:
+	// Constructor and destructor
+	fft1D(int size);
+	~fft1D(void);
+
+	// Functionality
+	void transform(double* data);
+
+	// Gets and sets
+	int getSize();
+};
+
+// A forward transform of a square power of two grid
+class fft2D
+{
+private:
+	int size;
+	fft1D* rows;
+	double* column;
+	void* plan;
+
+public:
+	// Constructor and destructor
+	fft2D(int size);
+	~fft2D(void);
+
+	// Functionality
+	void transform(double* data);
+	double* newGrid();
+	void deleteGrid(double* grid);
+
+	// Gets and sets
+	int getSize();
+};
+
+// Returns the smallest power of two that is not less than n
+int nextPowerOfTwo(int n);
+
+// Works out the normalised autocorrelation of a real series for the
+// lags 0 .. maxLag - 1
+void calculateAutocorrelation(const double* series, int length,
+							  double* result, int maxLag);
@@ -18,13 +18,49 @@
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <sstream>
 #include <ctime>
 using namespace std;
 #include "sample.h"
+#include "structurefactor.h"
+#include "pairstatistics.h"
+#include "scaling.h"
+#include "dynamics.h"
+#include "fft.h"
+#include "offlattice.h"
+#include "polysim.h"
+#include "progress.h"
+#include "wanglandau.h"
+#include "streaming.h"
+#include "enumeration.h"
+#include "resultcache.h"
 
 // Prototypes
+void runStaticGrowth();
+void runScalingTrajectory();
+void runDynamics();
+void runOffLattice();
+void runWangLandau();
+void runStreaming();
+void runEnumeration();
 void outputHistogramData(int bins, int sampleAmt, sample* s[], int data);
-double getMaxof(int data, sample* s[], int sampleAmt);
+void outputHistogramValues(int bins, int sampleAmt, double values[], 
+						   int data);
+void outputStructureFactor(int sampleAmt, int beadAmt, int beadsX[], 
+						   int beadsY[]);
+void outputArmData(int sampleAmt, double armData[]);
+void outputPairDistribution(pairStatistics* pairs);
+void outputScalingData(scalingTrajectory* trajectory);
+void outputDynamicsData(dynamics* d, double* acfRadiusofGyration, 
+						double* acfAsphericity, int maxLag);
+void outputDensityOfStates(wangLandau* wl);
+void outputThermodynamics(wangLandau* wl);
+double getIntegratedTime(double* acf, int maxLag);
+double getValueof(int data, sample* s);
+double getAverageof(int data, sample* s[], int sampleAmt);
+double getDeviationof(int data, sample* s[], int sampleAmt);
+double getAverageof(double values[], int sampleAmt);
+double getDeviationof(double values[], int sampleAmt);
 
 // Constants
 const int MAX_SAMPLES = 20000;
@@ -33,151 +69,277 @@ const int ASPHERICITY = 1;
 const int RADIUSOFGYRATION = 2;
 const int LAMDA1 = 4;
 const int LAMDA2 = 5;
+const int CONTACTS = 6;
+const int INTERSECTIONS = 7;
+const int HULLAREA = 8;
+const int HULLPERIMETER = 9;
+const int ARMRADIUSOFGYRATION = 10;
+const int BARRADIUSOFGYRATION = 11;
+const int ARMENDTOEND = 12;
+const int BRANCHSEPARATION = 13;
+const int ARMANGLE = 14;
+
+const int STATIC_GROWTH = 1;
+const int SCALING_TRAJECTORY = 2;
+const int DYNAMICS = 3;
+const int OFF_LATTICE = 4;
+const int WANG_LANDAU = 5;
+const int STREAMING = 6;
+const int EXACT_ENUMERATION = 7;
+
+// Defines the longest lag written out for an autocorrelation
+const int MAX_LAG = 100000;
+
+// Temperatures the density of states is reweighted to
+const double TEMPERATURE_STEP = 0.05;
+const double TEMPERATURE_MAX = 4.0;
+
+// Where live progress snapshots go. The socket is only served when
+// the environment names one.
+const char* const PROGRESS_FILE = "progress.json";
+const char* const PROGRESS_SOCKET_VARIABLE = "POLYSIM_SOCKET";
+
+// Where streamed results are kept between runs
+const char* const CACHE_DIRECTORY = "cache";
+
+// Defines the block size the enumeration check grows with. Chains
+// short enough to enumerate have arms of only a few beads, so full
+// size blocks would never be used.
+const int CHECK_BLOCK_STEPS = 2;
 
 ///////////////////////////////////////////////////////////////////////
 //*                                                                 *//
 //*  Function:  Main                                                *//
 //*                                                                 *//
+//*  Description:  Runs static growth with the same prompts as it   *//
+//*                always has. Any other mode is asked for by its   *//
+//*                number as the first command line argument, so    *//
+//*                input piped in for static growth still works.    *//
+//*                                                                 *//
 ///////////////////////////////////////////////////////////////////////
 //// Variables ////////////////////////////////////////////////////////
 //                                                                   //
-//  samples:            The array that holds pointers to sample      //
-//                      objects                                      //
-//                                                                   //
-//  outputFile:         output datafile stream                       //
-//                                                                   //
-//  beadAmt:            Bead amount                                  //
-//                                                                   //
-//  sampleAmt:          sample amount                                //
-//                                                                   //
-//  sum,sum2,sum3,sum4: temporary variables                          //
+//  mode:               which kind of run the user asked for         //
 //                                                                   //
 ///////////////////////////////////////////////////////////////////////
-int main()
+int main(int argc, char* argv[])
 {
 	// Set timeing information
 	int tStart, tEnd;
 	double elapsedTime;
+
+	// Variables
+	int mode = STATIC_GROWTH, pause;
 	
 	// Start timing
 	tStart = clock();
 
-	// Defines a list of pointers to instances of the sample class
-	sample* samples[MAX_SAMPLES];
+	// Set format
+	cout.setf(ios::fixed);
+
+	cout << "2D H-Comb Polymer Simulation\n\n";
+
+	// Mode from the command line
+	if(argc > 1)
+	{
+		mode = atoi(argv[1]);
+
+		if(mode < STATIC_GROWTH || mode > EXACT_ENUMERATION)
+		{
+			cout << "Usage: " << argv[0] << " [mode]\n\n";
+			cout << STATIC_GROWTH << ". Static Growth (default)\n";
+			cout << SCALING_TRAJECTORY << ". Scaling Trajectory\n";
+			cout << DYNAMICS << ". Dynamics\n";
+			cout << OFF_LATTICE << ". Off Lattice\n";
+			cout << WANG_LANDAU << ". Wang-Landau\n";
+			cout << STREAMING << ". Streaming\n";
+			cout << EXACT_ENUMERATION << ". Exact Enumeration\n";
+			exit(1);
+		}
+	}
+
+	switch(mode)
+	{
+	case SCALING_TRAJECTORY:
+		runScalingTrajectory();
+		break;
+
+	case DYNAMICS:
+		runDynamics();
+		break;
+
+	case OFF_LATTICE:
+		runOffLattice();
+		break;
+
+	case WANG_LANDAU:
+		runWangLandau();
+		break;
+
+	case STREAMING:
+		runStreaming();
+		break;
+
+	case EXACT_ENUMERATION:
+		runEnumeration();
+		break;
 
+	default:
+		runStaticGrowth();
+	}
+
+	// Calculate time
+	tEnd = clock();
+	elapsedTime = static_cast<double>(tEnd - tStart)/CLOCKS_PER_SEC;
+
+	cout << "\nTotal Time(seconds): " << elapsedTime;
+
+	// Wait
+	cin >> pause;
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  runStaticGrowth                                     *//
+//*                                                                 *//
+//*  Description:  Grows every sample through the library and       *//
+//*                outputs the averages, the per sample data and    *//
+//*                all of the histogram files. Only p(r) and S(q),  *//
+//*                which need the coordinates, are worked out here. *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  config:       the library run configuration                      //
+//                                                                   //
+//  run:          the library run the samples are grown by           //
+//                                                                   //
+//  values:       every quantity of every sample, in output order    //
+//                                                                   //
+//  armData:      every arm of every sample, POLYSIM_ARM_VALUES each //
+//                                                                   //
+//  beadsX,Y:     every bead of every sample, beadAmt each           //
+//                                                                   //
+//  conformation: one sample at a time loaded back for p(r)          //
+//                                                                   //
+//  outputFile:   output datafile stream                             //
+//                                                                   //
+//  beadAmt:      Bead amount                                        //
+//                                                                   //
+//  sampleAmt:    sample amount                                      //
+//                                                                   //
+//  tolerance:    relative error to stop early at, 0 for never       //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runStaticGrowth()
+{
 	// Output file stream
 	ofstream outputFile;
 
 	// Variables
-	int beadAmt, sampleAmt, pause;
-
-	// Temporary variables
-	double sum = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0;
-
-	// final avg vars
-	double avgLamda1 = 0.0,
-		   avgLamda1Sq = 0.0,
-		   avgLamda2 = 0.0,
-		   avgLamda2Sq = 0.0,
-		   avgAsphericity = 0.0,
-		   avgAsphericitySq = 0.0,
-		   avgRadiusOfGyration = 0.0,
-		   avgRadiusOfGyrationSq = 0.0;
-
-	// final standard deviations
-	double sdLamda1 = 0.0,
-		   sdLamda2 = 0.0,
-		   sdAsphericity = 0.0,
-		   sdRadiusOfGyration = 0.0;
+	int beadAmt, sampleAmt;
+	double tolerance = 0.0;
+
+	// Quantities in the order they are output
+	const int quantities[13] = {LAMDA1, LAMDA2, RADIUSOFGYRATION, 
+								ASPHERICITY, CONTACTS, INTERSECTIONS, 
+								HULLAREA, HULLPERIMETER, 
+								ARMRADIUSOFGYRATION, BARRADIUSOFGYRATION, 
+								ARMENDTOEND, BRANCHSEPARATION, ARMANGLE};
+	const char* names[13] = {"Lamda1  ", "Lamda2  ", "s^2     ", 
+							 "A       ", "Contacts", "Overlaps", 
+							 "Hull A  ", "Hull P  ", "Arm s^2 ", 
+							 "Bar s^2 ", "Arm R^2 ", "Branch R", 
+							 "Angle   "};
+	double* values[13];
+	double* armData;
+	int* beadsX;
+	int* beadsY;
+
+	// Short range pair counts, filled in as the samples are built
+	pairStatistics pairs;
+	sample conformation;
+
+	polysim_config config;
+	polysim_run* run;
 
 	// Set format
-	cout.setf(ios::fixed);
 	outputFile.setf(ios::fixed);
 
-	cout << "2D H-Comb Polymer Simulation\n\n";
-
 	// User input
 	cout << "Bead Amount: ";
 	cin >> beadAmt;
 	cout << "Sample Amount: ";
 	cin >> sampleAmt;
+	cout << "Stop At Relative Error (0 = never): ";
+	cin >> tolerance;
 
-	// Builds the samples
-	for(int i = 0; i < sampleAmt; i++)
+	polysim_default_config(&config);
+	config.beadAmount = beadAmt;
+	run = polysim_create(&config);
+
+	if(run == NULL || sampleAmt < 1)
 	{
-		sample* p = new sample();
-		samples[i] = p;
-		samples[i]->addBeads(beadAmt - 1);
+		cout << "Failed to create the run.\n";
+		exit(1);
 	}
 
-	// Gets average lamda1 and lamda2
-	for(int i = 0; i < sampleAmt; i++)
+	for(int q = 0; q < 13; q++)
 	{
-		sum += samples[i]->getLamda1();
-		sum2 += pow(samples[i]->getLamda1(), 2.0);
-		sum3 += samples[i]->getLamda2();
-		sum4 += pow(samples[i]->getLamda2(), 2.0);
+		values[q] = new double[sampleAmt];
 	}
 
-	avgLamda1 = sum / sampleAmt;
-	avgLamda1Sq = sum2 / sampleAmt;
-	avgLamda2 = sum3 / sampleAmt;
-	avgLamda2Sq = sum4 / sampleAmt;
-
-	// Standard deviation of lamda1 and lamda2
-	sdLamda1 = sqrt((avgLamda1Sq - avgLamda1 * avgLamda1) 
-			   / (sampleAmt - 1));
-	sdLamda2 = sqrt((avgLamda2Sq - avgLamda2 * avgLamda2) 
-		       / (sampleAmt - 1));
+	armData = new double[(long long)sampleAmt * POLYSIM_ARM_VALUES];
+	beadsX = new int[(long long)sampleAmt * beadAmt];
+	beadsY = new int[(long long)sampleAmt * beadAmt];
 
-	// Reset sums for use again
-	sum = 0.0;
-	sum2 = 0.0;
-	sum3 = 0.0;
-	sum4 = 0.0;
+	progressMonitor progress(sampleAmt, tolerance, PROGRESS_FILE, 
+							 getenv(PROGRESS_SOCKET_VARIABLE));
+	progress.start();
 
-	// gets average asphericity and radius of gyration
+	// Builds the samples one at a time so the run can stop early.
+	// Contacts and overlaps come out of the same pass as p(r).
 	for(int i = 0; i < sampleAmt; i++)
 	{
-		sum += samples[i]->getAsphericity();
-		sum2 += pow(samples[i]->getAsphericity(), 2.0);
-		sum3 += samples[i]->getRadiusofGyration();
-		sum4 += pow(samples[i]->getRadiusofGyration(), 2.0);
+		polysim_results row;
+
+		row.lamda1 = values[0] + i;
+		row.lamda2 = values[1] + i;
+		row.radiusOfGyration = values[2] + i;
+		row.asphericity = values[3] + i;
+		row.contacts = NULL;
+		row.selfIntersections = NULL;
+		row.hullArea = values[6] + i;
+		row.hullPerimeter = values[7] + i;
+		row.armRadiusOfGyration = values[8] + i;
+		row.barRadiusOfGyration = values[9] + i;
+		row.armEndToEnd = values[10] + i;
+		row.branchSeparation = values[11] + i;
+		row.armAngle = values[12] + i;
+		row.armData = armData + (long long)i * POLYSIM_ARM_VALUES;
+		row.beadsX = beadsX + (long long)i * beadAmt;
+		row.beadsY = beadsY + (long long)i * beadAmt;
+
+		polysim_generate(run, &row, 1);
+
+		conformation.setBeads(row.beadsX, row.beadsY, beadAmt);
+		pairs.addSample(&conformation);
+		values[4][i] = conformation.getContacts();
+		values[5][i] = conformation.getSelfIntersections();
+
+		progress.addValues(values[0][i], values[1][i], values[2][i], 
+						   values[3][i]);
+
+		if(progress.isConverged())
+		{
+			sampleAmt = i + 1;
+		}
 	}
 
-	avgAsphericitySq = sum2 / sampleAmt;
-	avgAsphericity = sum / sampleAmt;
-	avgRadiusOfGyrationSq = sum4 / sampleAmt;
-	avgRadiusOfGyration = sum3 / sampleAmt;
-
-	// Gets the standard deviation of the mean of asphericity and radius of
-	// gyration
-	sdAsphericity = sqrt((avgAsphericitySq - avgAsphericity 
-		            * avgAsphericity) / (sampleAmt - 1));
-	sdRadiusOfGyration = sqrt((avgRadiusOfGyrationSq - 
-				         avgRadiusOfGyration * avgRadiusOfGyration) 
-						 / (sampleAmt - 1));
-
-	// Output data to screen
-	cout << endl;
-	cout << "Beads: " << beadAmt << endl;
-	cout << "Samples: " << sampleAmt << endl;
-	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
-		 << "Standard Deviation\n";
-	cout << "-----------------------------------------------\n";
-	cout << "Lamda1  " << setw(15) << setprecision(6) << avgLamda1 
-		               << setw(18) << setprecision(6) << sdLamda1 
-					   << endl;
-	cout << "Lamda2  " << setw(15) << setprecision(6) << avgLamda2 
-					   << setw(18) << setprecision(6) << sdLamda2 
-					   << endl;
-	cout << "s^2     " << setw(15) << setprecision(6) 
-					   << avgRadiusOfGyration 
-		               << setw(18) << setprecision(6) 
-					   << sdRadiusOfGyration << endl;
-	cout << "A       " << setw(15) << setprecision(6) << avgAsphericity 
-		               << setw(18) << setprecision(6) << sdAsphericity 
-					   << endl;
+	progress.finish();
+	polysim_destroy(run);
 
 	// Build output
 	outputFile.open("output.txt");
@@ -188,266 +350,1585 @@ int main()
 		exit(1);
 	}
 
-	outputFile << "2D H-Comb Polymer Simulation" << "\n\n";
+	// Output data to screen
+	cout << endl;
+	cout << "Beads: " << beadAmt << endl;
+	cout << "Samples: " << sampleAmt << endl;
+	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		 << "Standard Deviation\n";
+	cout << "-----------------------------------------------\n";
 
+	outputFile << "2D H-Comb Polymer Simulation" << "\n\n";
 	outputFile << "Beads: " << beadAmt << endl;
 	outputFile << "Samples: " << sampleAmt << endl;
-
 	outputFile << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
-		 << "Standard Deviation\n";
+		       << "Standard Deviation\n";
 	outputFile << "-----------------------------------------------\n";
-	outputFile << "Lamda1  " << setw(15) << setprecision(6) << avgLamda1 
-		               << setw(18) << setprecision(6) << sdLamda1 
-					   << endl;
-	outputFile << "Lamda2  " << setw(15) << setprecision(6) << avgLamda2 
-					   << setw(18) << setprecision(6) << sdLamda2 
-					   << endl;
-	outputFile << "s^2     " << setw(15) << setprecision(6) 
-					   << avgRadiusOfGyration 
-		               << setw(18) << setprecision(6) 
-					   << sdRadiusOfGyration << endl;
-	outputFile << "A       " << setw(15) << setprecision(6) << avgAsphericity 
-		               << setw(18) << setprecision(6) << sdAsphericity 
-					   << endl << endl;
+
+	for(int q = 0; q < 13; q++)
+	{
+		double avg = getAverageof(values[q], sampleAmt);
+		double sd = getDeviationof(values[q], sampleAmt);
+
+		cout << names[q] << setw(15) << setprecision(6) << avg 
+			 << setw(18) << setprecision(6) << sd << endl;
+		outputFile << names[q] << setw(15) << setprecision(6) << avg 
+			       << setw(18) << setprecision(6) << sd << endl;
+	}
+
+	outputFile << endl;
 
 	outputFile << "Lamda1" << "\t" << "Lamda2" << "\t" 
 		       << "s^2" << "\t" << "A\n";
 
 	for(int i = 0; i < sampleAmt; i++)
 	{
-		outputFile << samples[i]->getLamda1() << "\t" 
+		outputFile << values[0][i] << "\t" 
 			       << setprecision(6) 
-			       << samples[i]->getLamda2() << "\t" 
+			       << values[1][i] << "\t" 
 				   << setprecision(6) 
-				   << samples[i]->getRadiusofGyration() << "\t" 
+				   << values[2][i] << "\t" 
 				   << setprecision(6) 
-				   << samples[i]->getAsphericity() << "\t" 
+				   << values[3][i] << "\t" 
 				   << endl;
 	}
 
 	outputFile.close();
 
 	// Output the histrogram data for all quantities
-	outputHistogramData(20, sampleAmt, samples, RADIUSOFGYRATION);
-	outputHistogramData(20, sampleAmt, samples, ASPHERICITY);
-	outputHistogramData(20, sampleAmt, samples, LAMDA1);
-	outputHistogramData(20, sampleAmt, samples, LAMDA2);
+	for(int q = 0; q < 13; q++)
+	{
+		outputHistogramValues(20, sampleAmt, values[q], quantities[q]);
+	}
 
-	// Calculate time
-	tEnd = clock();
-	elapsedTime = static_cast<double>(tEnd - tStart)/CLOCKS_PER_SEC;
+	// Output every arm of every sample
+	outputArmData(sampleAmt, armData);
 
-	cout << "\nTotal Time(seconds): " << elapsedTime;
+	// Output the short range pair distance distribution
+	outputPairDistribution(&pairs);
 
-	// Wait
-	cin >> pause;
+	// Output the ensemble averaged structure factor
+	outputStructureFactor(sampleAmt, beadAmt, beadsX, beadsY);
 
-	return 0;
+	for(int q = 0; q < 13; q++)
+	{
+		delete [] values[q];
+	}
+
+	delete [] armData;
+	delete [] beadsX;
+	delete [] beadsY;
 }
 
 ///////////////////////////////////////////////////////////////////////
 //*                                                                 *//
-//*  Function:  outputHistogramData                                 *//
+//*  Function:  runScalingTrajectory                                *//
 //*                                                                 *//
-//*  Description:  Outputs a datafile for construction a histogram. *//
+//*  Description:  Grows every sample once to the largest bead      *//
+//*                amount, taking its shape at a geometric series   *//
+//*                of smaller bead amounts on the way, and fits the *//
+//*                Flory exponent to <s^2> against N.               *//
 //*                                                                 *//
 ///////////////////////////////////////////////////////////////////////
 //// Variables ////////////////////////////////////////////////////////
 //                                                                   //
-//  MAX_BINS:     max amount of bins                                 //
-//                                                                   //
-//  binSize:      bin size                                           //
+//  smallestAmt:  bead amount of the first checkpoint                //
 //                                                                   //
-//  temp:         temporary variable, hold asphericity               //
-//                                                                   //
-//  histInfoFile: output file stream                                 //
+//  largestAmt:   bead amount of the last checkpoint                 //
 //                                                                   //
-//  range:        array that holds the upper bounds for each bin     //
+//  ratio:        growth factor between checkpoints                  //
 //                                                                   //
-//  count:        array that holds the count for each bin            //
+//  sampleAmt:    sample amount                                      //
 //                                                                   //
 ///////////////////////////////////////////////////////////////////////
-void outputHistogramData(int bins, int sampleAmt, sample* s[], int data)
+void runScalingTrajectory()
 {
-	const int MAX_BINS = 35;
-	double binSize = getMaxof(data, s, sampleAmt) / bins;
-	double temp;
+	int smallestAmt, largestAmt, sampleAmt;
+	double ratio;
 
-	// Output file stream
-	ofstream histInfoFile;
+	// User input
+	cout << "Smallest Bead Amount: ";
+	cin >> smallestAmt;
+	cout << "Largest Bead Amount: ";
+	cin >> largestAmt;
+	cout << "Checkpoint Ratio: ";
+	cin >> ratio;
+	cout << "Sample Amount: ";
+	cin >> sampleAmt;
 
-	double range[MAX_BINS];
-	int count[MAX_BINS];
+	scalingTrajectory trajectory(smallestAmt, largestAmt, ratio);
 
-	// Initialize arrays
-	for(int i = 1; i <= bins; i++)
+	for(int i = 0; i < sampleAmt; i++)
 	{
-		count[i - 1] = 0;
-		range[i - 1] = (double)i * binSize;
+		trajectory.addSample();
 	}
 
-	// Build histogram data
-	switch(data)
-	{
-	case ASPHERICITY:
-
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			temp = s[i]->getAsphericity();
-
-			for(int j = 0; j < bins; j++)
-			{
-				if(temp <= range[j])
-				{
-					count[j]++;
-					break;
-				}
-			}
-		}
-
-		histInfoFile.open("AsphericityHistData.txt");
-
-		break;
-	case RADIUSOFGYRATION:
-
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			temp = s[i]->getRadiusofGyration();
-
-			for(int j = 0; j < bins; j++)
-			{
-				if(temp <= range[j])
-				{
-					count[j]++;
-					break;
-				}
-			}
-		}
-
-		histInfoFile.open("ROGHistData.txt");
-
-		break;
+	trajectory.fitExponent();
 
-	case LAMDA1:
+	// Output data to screen
+	cout << endl;
+	cout << "Samples: " << sampleAmt << endl;
+	cout << "\n\nBeads" << setw(12) << "Lamda1" << setw(12) << "Lamda2" 
+		 << setw(12) << "s^2" << setw(12) << "A\n";
+	cout << "-----------------------------------------------------\n";
 
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			temp = s[i]->getLamda1();
+	for(int c = 0; c < trajectory.getCheckpointCount(); c++)
+	{
+		cout << setw(5) << trajectory.getBeads(c) 
+			 << setw(12) << setprecision(4) << trajectory.getLamda1(c) 
+			 << setw(12) << setprecision(4) << trajectory.getLamda2(c) 
+			 << setw(12) << setprecision(4) 
+			 << trajectory.getRadiusofGyration(c) 
+			 << setw(12) << setprecision(4) 
+			 << trajectory.getAsphericity(c) << endl;
+	}
 
-			for(int j = 0; j < bins; j++)
-			{
-				if(temp <= range[j])
-				{
-					count[j]++;
-					break;
-				}
-			}
-		}
+	cout << "\nnu = " << setprecision(6) << trajectory.getExponent() 
+		 << " +/- " << setprecision(6) << trajectory.getExponentError() 
+		 << endl;
 
-		histInfoFile.open("Lamda1HistData.txt");
+	outputScalingData(&trajectory);
+}
 
-		break;
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  runDynamics                                         *//
+//*                                                                 *//
+//*  Description:  Grows one sample and evolves it with local       *//
+//*                lattice moves, then outputs the time series of   *//
+//*                s^2 and A and their autocorrelation functions.   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  beadAmt:      bead amount                                        //
+//                                                                   //
+//  moves:        number of attempted moves                          //
+//                                                                   //
+//  interval:     attempted moves between points of the series       //
+//                                                                   //
+//  excluded:     1 to forbid two beads on one site, 0 to allow it   //
+//                                                                   //
+//  acf...:       autocorrelation functions of s^2 and A             //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runDynamics()
+{
+	int beadAmt, excluded, maxLag;
+	long long moves, interval;
 
-	case LAMDA2:
+	// User input
+	cout << "Bead Amount: ";
+	cin >> beadAmt;
+	cout << "Moves: ";
+	cin >> moves;
+	cout << "Record Interval: ";
+	cin >> interval;
+	cout << "Excluded Volume (1 = yes, 0 = no): ";
+	cin >> excluded;
 
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			temp = s[i]->getLamda2();
+	sample* s = new sample();
+	s->addBeads(beadAmt - 1);
 
-			for(int j = 0; j < bins; j++)
-			{
-				if(temp <= range[j])
-				{
-					count[j]++;
-					break;
-				}
-			}
-		}
+	dynamics* d = new dynamics(s, excluded == 1);
+	d->run(moves, interval);
 
-		histInfoFile.open("Lamda2HistData.txt");
+	// Autocorrelations out to half the series
+	maxLag = d->getSeriesLength() / 2;
 
-		break;
+	if(maxLag > MAX_LAG)
+	{
+		maxLag = MAX_LAG;
 	}
 
-	// Build output
-
-	if(histInfoFile.fail())
+	if(maxLag < 1)
 	{
-		cout << "Failed to open histogram file.\n";
-		exit(1);
+		maxLag = 1;
 	}
 
-	histInfoFile << "Bin\tFrequency\n";
+	double* acfRadiusofGyration = new double[maxLag];
+	double* acfAsphericity = new double[maxLag];
 
-	for(int i = 0; i < bins; i++)
+	calculateAutocorrelation(d->getRadiusofGyrationSeries(), 
+							 d->getSeriesLength(), acfRadiusofGyration, 
+							 maxLag);
+	calculateAutocorrelation(d->getAsphericitySeries(), 
+							 d->getSeriesLength(), acfAsphericity, maxLag);
+
+	double sumRadiusofGyration = 0.0, sumAsphericity = 0.0;
+
+	for(int i = 0; i < d->getSeriesLength(); i++)
 	{
-		histInfoFile << range[i] << "\t" << count[i] << endl;
+		sumRadiusofGyration += d->getRadiusofGyrationSeries()[i];
+		sumAsphericity += d->getAsphericitySeries()[i];
 	}
 
-	histInfoFile.close();
+	// Output data to screen
+	cout << endl;
+	cout << "Beads: " << d->getBeadCount() << endl;
+	cout << "Moves: " << d->getAttemptedMoves() << endl;
+	cout << "Accepted: " << setprecision(6) 
+		 << (double)d->getAcceptedMoves() / d->getAttemptedMoves() << endl;
+	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		 << "Tau (moves)\n";
+	cout << "-----------------------------------------------\n";
+	cout << "s^2     " << setw(15) << setprecision(6) 
+		 << sumRadiusofGyration / d->getSeriesLength() 
+		 << setw(18) << setprecision(1) 
+		 << getIntegratedTime(acfRadiusofGyration, maxLag) 
+		    * d->getRecordInterval() << endl;
+	cout << "A       " << setw(15) << setprecision(6) 
+		 << sumAsphericity / d->getSeriesLength() 
+		 << setw(18) << setprecision(1) 
+		 << getIntegratedTime(acfAsphericity, maxLag) 
+		    * d->getRecordInterval() << endl;
+	cout << setprecision(6);
+
+	outputDynamicsData(d, acfRadiusofGyration, acfAsphericity, maxLag);
+
+	delete [] acfRadiusofGyration;
+	delete [] acfAsphericity;
+	delete d;
+	delete s;
 }
 
 ///////////////////////////////////////////////////////////////////////
 //*                                                                 *//
-//*  Function:  getMaxof                                            *//
+//*  Function:  runOffLattice                                       *//
 //*                                                                 *//
-//*  Description:  Returns the max value in a given data set. This  *//
-//*                is used by our outputHistogramData function.     *//
+//*  Description:  Builds freely jointed or wormlike samples off    *//
+//*                the lattice and outputs the averages, the per    *//
+//*                sample data and the shape histograms.            *//
 //*                                                                 *//
 ///////////////////////////////////////////////////////////////////////
-double getMaxof(int data, sample* s[], int sampleAmt)
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  samples:      The array that holds pointers to sample objects    //
+//                                                                   //
+//  grower:       off lattice grower shared by every sample          //
+//                                                                   //
+//  stiffness:    bending stiffness, 0 for a freely jointed chain    //
+//                                                                   //
+//  tolerance:    relative error to stop early at, 0 for never       //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runOffLattice()
 {
-	double max = 0;
+	// Defines a list of pointers to instances of the sample class
+	sample* samples[MAX_SAMPLES];
 
-	switch(data)
-	{
-	case ASPHERICITY:
+	// Output file stream
+	ofstream outputFile;
 
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			if(s[i]->getAsphericity() > max)
-			{
-				max = s[i]->getAsphericity();
-			}
-		}
+	// Variables
+	int beadAmt, sampleAmt;
+	double stiffness, tolerance = 0.0;
 
-		break;
-	case RADIUSOFGYRATION:
+	// Quantities in the order they are output
+	const int quantities[4] = {LAMDA1, LAMDA2, RADIUSOFGYRATION, 
+							   ASPHERICITY};
+	const char* names[4] = {"Lamda1  ", "Lamda2  ", "s^2     ", 
+							"A       "};
 
-		for(int i = 0; i < sampleAmt; i++)
-		{
-			if(s[i]->getRadiusofGyration() > max)
-			{
-				max = s[i]->getRadiusofGyration();
-			}
+	// User input
+	cout << "Bead Amount: ";
+	cin >> beadAmt;
+	cout << "Sample Amount: ";
+	cin >> sampleAmt;
+	cout << "Stiffness (0 = freely jointed): ";
+	cin >> stiffness;
+	cout << "Stop At Relative Error (0 = never): ";
+	cin >> tolerance;
+
+	// The samples and the grower's own arrays are fixed in size
+	if(beadAmt < 1 || beadAmt > MAX_BEADS || sampleAmt < 1
+		|| sampleAmt > MAX_SAMPLES)
+	{
+		cout << "Failed to create the run.\n";
+		exit(1);
+	}
+
+	offLatticeGrowth* grower = new offLatticeGrowth(stiffness);
+	progressMonitor progress(sampleAmt, tolerance, PROGRESS_FILE, 
+							 getenv(PROGRESS_SOCKET_VARIABLE));
+	progress.start();
+
+	// Builds the samples
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		samples[i] = new sample();
+		grower->grow(samples[i], beadAmt - 1);
+		progress.addSample(samples[i]);
+
+		if(progress.isConverged())
+		{
+			sampleAmt = i + 1;
 		}
+	}
 
-		break;
+	progress.finish();
+	delete grower;
 
-	case LAMDA1:
+	// Build output
+	outputFile.open("output.txt");
 
-		for(int i = 0; i < sampleAmt; i++)
+	if(outputFile.fail())
+	{
+		cout << "Failed to open output file.\n";
+		exit(1);
+	}
+
+	outputFile.setf(ios::fixed);
+
+	cout << endl;
+	cout << "Beads: " << beadAmt << endl;
+	cout << "Samples: " << sampleAmt << endl;
+	cout << "Stiffness: " << setprecision(6) << stiffness << endl;
+	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		 << "Standard Deviation\n";
+	cout << "-----------------------------------------------\n";
+
+	outputFile << "2D H-Comb Polymer Simulation (Off Lattice)" << "\n\n";
+	outputFile << "Beads: " << beadAmt << endl;
+	outputFile << "Samples: " << sampleAmt << endl;
+	outputFile << "Stiffness: " << setprecision(6) << stiffness << endl;
+	outputFile << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		       << "Standard Deviation\n";
+	outputFile << "-----------------------------------------------\n";
+
+	for(int q = 0; q < 4; q++)
+	{
+		double avg = getAverageof(quantities[q], samples, sampleAmt);
+		double sd = getDeviationof(quantities[q], samples, sampleAmt);
+
+		cout << names[q] << setw(15) << setprecision(6) << avg 
+			 << setw(18) << setprecision(6) << sd << endl;
+		outputFile << names[q] << setw(15) << setprecision(6) << avg 
+			       << setw(18) << setprecision(6) << sd << endl;
+	}
+
+	outputFile << endl << "Lamda1" << "\t" << "Lamda2" << "\t" 
+		       << "s^2" << "\t" << "A\n";
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		outputFile << samples[i]->getLamda1() << "\t" 
+			       << setprecision(6) 
+			       << samples[i]->getLamda2() << "\t" 
+				   << setprecision(6) 
+				   << samples[i]->getRadiusofGyration() << "\t" 
+				   << setprecision(6) 
+				   << samples[i]->getAsphericity() << "\t" 
+				   << endl;
+	}
+
+	outputFile.close();
+
+	// Output the histrogram data for all quantities
+	outputHistogramData(20, sampleAmt, samples, RADIUSOFGYRATION);
+	outputHistogramData(20, sampleAmt, samples, ASPHERICITY);
+	outputHistogramData(20, sampleAmt, samples, LAMDA1);
+	outputHistogramData(20, sampleAmt, samples, LAMDA2);
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		delete samples[i];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  runWangLandau                                       *//
+//*                                                                 *//
+//*  Description:  Works out the density of states of a self        *//
+//*                avoiding H-Comb with contact attraction, then    *//
+//*                outputs it and its reweighting to a range of     *//
+//*                temperatures.                                    *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  beadAmt:      bead amount                                        //
+//                                                                   //
+//  windowAmt:    energy windows asked for, one thread each          //
+//                                                                   //
+//  finalLnF:     modification factor the run stops below            //
+//                                                                   //
+//  peak...:      temperature and height of the heat capacity peak   //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runWangLandau()
+{
+	int beadAmt, windowAmt;
+	double finalLnF, peakTemperature = 0.0, peakHeatCapacity = 0.0;
+
+	// User input
+	cout << "Bead Amount: ";
+	cin >> beadAmt;
+	cout << "Windows: ";
+	cin >> windowAmt;
+	cout << "Final ln f: ";
+	cin >> finalLnF;
+
+	// Only the bonds of the grown sample are used
+	sample* s = new sample();
+	s->addBeads(beadAmt - 1);
+
+	wangLandau* wl = new wangLandau(s, windowAmt, finalLnF);
+	wl->run();
+
+	// The collapse shows up as a peak in the heat capacity
+	for(double t = TEMPERATURE_STEP; t <= TEMPERATURE_MAX + 1e-9; 
+		t += TEMPERATURE_STEP)
+	{
+		double energy, heatCapacity, radiusofGyration, asphericity;
+
+		wl->reweight(t, energy, heatCapacity, radiusofGyration, 
+					 asphericity);
+
+		if(heatCapacity > peakHeatCapacity)
 		{
-			if(s[i]->getLamda1() > max)
-			{
-				max = s[i]->getLamda1();
-			}
+			peakHeatCapacity = heatCapacity;
+			peakTemperature = t;
 		}
+	}
 
-		break;
+	// Output data to screen
+	cout << endl;
+	cout << "Beads: " << wl->getBeadCount() << endl;
+	cout << "Windows: " << wl->getWindowCount() << endl;
+	cout << "Most Contacts: " << wl->getMaxContacts() << endl;
+	cout << "Rounds: " << wl->getRounds() << endl;
+	cout << "Accepted: " << setprecision(6) << wl->getAcceptance() 
+		 << endl;
+	cout << "Exchanges: " << setprecision(6) 
+		 << wl->getExchangeAcceptance() << endl;
+	cout << "Peak C: " << setprecision(6) << peakHeatCapacity 
+		 << " at T = " << setprecision(6) << peakTemperature << endl;
+
+	outputDensityOfStates(wl);
+	outputThermodynamics(wl);
+
+	delete wl;
+	delete s;
+}
 
-	case LAMDA2:
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  runStreaming                                        *//
+//*                                                                 *//
+//*  Description:  Grows samples without keeping their beads, so    *//
+//*                chains can be far longer than MAX_BEADS, and     *//
+//*                outputs the averages, the per sample data and    *//
+//*                the shape histograms. Samples an earlier run     *//
+//*                with the same settings kept are read back from   *//
+//*                the cache rather than grown.                     *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  values:       each quantity of every sample, in output order,    //
+//                held by the cache                                  //
+//                                                                   //
+//  grower:       streaming grower shared by every sample            //
+//                                                                   //
+//  beadAmt:      bead amount, which can be above MAX_BEADS          //
+//                                                                   //
+//  blockStepping: 1 to grow BLOCK_STEPS beads per table lookup      //
+//                                                                   //
+//  seed:         seed every sample's rand state is made from        //
+//                                                                   //
+//  cache:        samples kept from earlier runs with the same key   //
+//                                                                   //
+//  tolerance:    relative error to stop early at, 0 for never       //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runStreaming()
+{
+	// Output file stream
+	ofstream outputFile;
+
+	// Variables
+	long long beadAmt;
+	int sampleAmt, blockStepping, cachedAmt;
+	unsigned int seed;
+	double tolerance = 0.0;
+
+	// Quantities in the order they are output
+	const int quantities[4] = {LAMDA1, LAMDA2, RADIUSOFGYRATION, 
+							   ASPHERICITY};
+	const char* names[4] = {"Lamda1  ", "Lamda2  ", "s^2     ", 
+							"A       "};
+
+	// User input
+	cout << "Bead Amount: ";
+	cin >> beadAmt;
+	cout << "Sample Amount: ";
+	cin >> sampleAmt;
+	cout << "Block Stepping (0 = off, 1 = on): ";
+	cin >> blockStepping;
+	cout << "Seed: ";
+	cin >> seed;
+	cout << "Stop At Relative Error (0 = never): ";
+	cin >> tolerance;
+
+	// Everything a streamed sample depends on
+	ostringstream key;
+	key << "streaming " << STREAMING_VERSION << " library " 
+		<< polysim_version() << " topology hcomb beads " << beadAmt 
+		<< " blocks " << (blockStepping != 0) << " seed " << seed;
+
+	resultCache* cache = new resultCache(CACHE_DIRECTORY, key.str());
+	cache->load();
+	cachedAmt = cache->getSampleCount();
+
+	if(cache->isDamaged())
+	{
+		cout << "Result cache " << cache->getFileName() 
+			 << " is damaged, only " << cachedAmt 
+			 << " samples could be read.\n";
+	}
+
+	streamingGrowth* grower = new streamingGrowth((blockStepping != 0) 
+												  ? BLOCK_STEPS : 0);
+	progressMonitor progress(sampleAmt, tolerance, PROGRESS_FILE, 
+							 getenv(PROGRESS_SOCKET_VARIABLE));
+	progress.start();
+
+	// Builds the samples that are not kept already
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		if(i >= cache->getSampleCount())
+		{
+			shape result;
+
+			srand(getSampleSeed(seed, i));
+			grower->grow(beadAmt - 1, result);
+			cache->addSample(result.lamda1, result.lamda2, 
+							 result.radiusofGyration, result.asphericity);
+		}
+
+		progress.addValues(cache->getValues(0)[i], cache->getValues(1)[i],
+						   cache->getValues(2)[i], cache->getValues(3)[i]);
+
+		if(progress.isConverged())
+		{
+			sampleAmt = i + 1;
+		}
+	}
+
+	progress.finish();
+	delete grower;
+
+	// A damaged file is written again whole even if nothing was added
+	if((cache->getSampleCount() > cachedAmt || cache->isDamaged()) 
+		&& !cache->save())
+	{
+		cout << "Failed to write result cache.\n";
+	}
+
+	if(cachedAmt > sampleAmt)
+	{
+		cachedAmt = sampleAmt;
+	}
+
+	double* values[4];
+
+	for(int q = 0; q < 4; q++)
+	{
+		values[q] = cache->getValues(q);
+	}
+
+	// Build output
+	outputFile.open("output.txt");
+
+	if(outputFile.fail())
+	{
+		cout << "Failed to open output file.\n";
+		exit(1);
+	}
+
+	outputFile.setf(ios::fixed);
+
+	cout << endl;
+	cout << "Beads: " << beadAmt << endl;
+	cout << "Samples: " << sampleAmt << endl;
+	cout << "Block Stepping: " << (blockStepping ? "on" : "off") << endl;
+	cout << "Seed: " << seed << endl;
+	cout << "From Cache: " << cachedAmt << endl;
+	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		 << "Standard Deviation\n";
+	cout << "-----------------------------------------------\n";
+
+	outputFile << "2D H-Comb Polymer Simulation (Streaming)" << "\n\n";
+	outputFile << "Beads: " << beadAmt << endl;
+	outputFile << "Samples: " << sampleAmt << endl;
+	outputFile << "Block Stepping: " << (blockStepping ? "on" : "off") 
+		       << endl;
+	outputFile << "Seed: " << seed << endl;
+	outputFile << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		       << "Standard Deviation\n";
+	outputFile << "-----------------------------------------------\n";
+
+	for(int q = 0; q < 4; q++)
+	{
+		double sum = 0.0, sum2 = 0.0, avg, sd;
 
 		for(int i = 0; i < sampleAmt; i++)
 		{
-			if(s[i]->getLamda2() > max)
-			{
-				max = s[i]->getLamda2();
-			}
+			sum += values[q][i];
+			sum2 += values[q][i] * values[q][i];
 		}
 
-		break;
+		avg = sum / sampleAmt;
+		sd = sqrt((sum2 / sampleAmt - avg * avg) / (sampleAmt - 1));
+
+		cout << names[q] << setw(15) << setprecision(6) << avg 
+			 << setw(18) << setprecision(6) << sd << endl;
+		outputFile << names[q] << setw(15) << setprecision(6) << avg 
+			       << setw(18) << setprecision(6) << sd << endl;
+	}
+
+	outputFile << endl << "Lamda1" << "\t" << "Lamda2" << "\t" 
+		       << "s^2" << "\t" << "A\n";
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		outputFile << values[0][i] << "\t" 
+			       << setprecision(6) 
+			       << values[1][i] << "\t" 
+				   << setprecision(6) 
+				   << values[2][i] << "\t" 
+				   << setprecision(6) 
+				   << values[3][i] << "\t" 
+				   << endl;
+	}
+
+	outputFile.close();
+
+	// Output the histrogram data for all quantities
+	for(int q = 0; q < 4; q++)
+	{
+		outputHistogramValues(20, sampleAmt, values[q], quantities[q]);
+	}
+
+	delete cache;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  runEnumeration                                      *//
+//*                                                                 *//
+//*  Description:  Works out the exact averages over every random   *//
+//*                walk H-Comb of a bead amount, then checks each   *//
+//*                lattice sampling engine against them.            *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  enumeration:  the exact enumeration                              //
+//                                                                   //
+//  exact:        exact averages                                     //
+//                                                                   //
+//  spread:       standard deviations over all conformations         //
+//                                                                   //
+//  checkAmt:     samples each engine grows for the check, 0 for     //
+//                no check                                           //
+//                                                                   //
+//  sum:          sums of each quantity over an engine's samples     //
+//                                                                   //
+//  used:         samples in each sum, 0 for a quantity the engine   //
+//                does not record                                    //
+//                                                                   //
+//  independent:  uncorrelated samples the sums are worth            //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void runEnumeration()
+{
+	// Output file stream
+	ofstream outputFile;
+
+	// Variables
+	int beadAmt, checkAmt;
+	shape exact, spread;
+
+	const char* names[4] = {"Lamda1  ", "Lamda2  ", "s^2     ", 
+							"A       "};
+	const char* engines[4] = {"Static Growth ", "Streaming     ", 
+							  "Block Stepping", "Dynamics      "};
+
+	// User input
+	cout << "Bead Amount: ";
+	cin >> beadAmt;
+	cout << "Check Samples (0 = none): ";
+	cin >> checkAmt;
+
+	exactEnumeration* enumeration = new exactEnumeration(beadAmt);
+	enumeration->run();
+	enumeration->getAverages(exact);
+	enumeration->getDeviations(spread);
+	beadAmt = enumeration->getBeadCount();
+
+	double exactValues[4] = {exact.lamda1, exact.lamda2, 
+							 exact.radiusofGyration, exact.asphericity};
+	double spreadValues[4] = {spread.lamda1, spread.lamda2, 
+							  spread.radiusofGyration, spread.asphericity};
+
+	// Build output
+	outputFile.open("output.txt");
+
+	if(outputFile.fail())
+	{
+		cout << "Failed to open output file.\n";
+		exit(1);
 	}
 
-	return max;
+	outputFile.setf(ios::fixed);
+
+	cout << endl;
+	cout << "Beads: " << beadAmt << endl;
+	cout << "Conformations: " << enumeration->getConformations() << endl;
+	cout << "Threads: " << enumeration->getThreadCount() << endl;
+	cout << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		 << "Standard Deviation\n";
+	cout << "-----------------------------------------------\n";
+
+	outputFile << "2D H-Comb Polymer Simulation (Exact Enumeration)" 
+			   << "\n\n";
+	outputFile << "Beads: " << beadAmt << endl;
+	outputFile << "Conformations: " << enumeration->getConformations() 
+			   << endl;
+	outputFile << "\n\nQuantity" << setw(13) << "Average" << setw(27) 
+		       << "Standard Deviation\n";
+	outputFile << "-----------------------------------------------\n";
+
+	for(int q = 0; q < 4; q++)
+	{
+		cout << names[q] << setw(15) << setprecision(6) << exactValues[q] 
+			 << setw(18) << setprecision(6) << spreadValues[q] << endl;
+		outputFile << names[q] << setw(15) << setprecision(6) 
+				   << exactValues[q] << setw(18) << setprecision(6) 
+				   << spreadValues[q] << endl;
+	}
+
+	delete enumeration;
+
+	if(checkAmt < 2)
+	{
+		outputFile.close();
+		return;
+	}
+
+	// How far each engine's averages are from the exact ones, in
+	// standard deviations of the mean
+	cout << "\n\nEngine" << setw(18) << "Lamda1" << setw(10) << "Lamda2" 
+		 << setw(10) << "s^2" << setw(10) << "A" << endl;
+	cout << "------------------------------------------------------\n";
+
+	outputFile << "\n\nEngine" << setw(18) << "Lamda1" << setw(10) 
+			   << "Lamda2" << setw(10) << "s^2" << setw(10) << "A" << endl;
+	outputFile << "------------------------------------------------------\n";
+
+	sample* s = new sample();
+
+	for(int engine = 0; engine < 4; engine++)
+	{
+		double sum[4] = {0.0, 0.0, 0.0, 0.0};
+		double used[4], independent[4];
+
+		for(int q = 0; q < 4; q++)
+		{
+			used[q] = checkAmt;
+			independent[q] = checkAmt;
+		}
+
+		if(engine == 0)
+		{
+			polysim_config config;
+			polysim_results row = {NULL};
+			shape result;
+
+			polysim_default_config(&config);
+			config.beadAmount = beadAmt;
+			polysim_run* run = polysim_create(&config);
+
+			row.lamda1 = &result.lamda1;
+			row.lamda2 = &result.lamda2;
+			row.radiusOfGyration = &result.radiusofGyration;
+			row.asphericity = &result.asphericity;
+
+			for(int i = 0; i < checkAmt; i++)
+			{
+				polysim_generate(run, &row, 1);
+				sum[0] += result.lamda1;
+				sum[1] += result.lamda2;
+				sum[2] += result.radiusofGyration;
+				sum[3] += result.asphericity;
+			}
+
+			polysim_destroy(run);
+		}
+		else if(engine == 3)
+		{
+			// A dynamics run without excluded volume keeps the random
+			// walk ensemble, recorded once a sweep. It only records
+			// s^2 and A, and its records count once every 2 tau.
+			s->reset();
+			s->addBeads(beadAmt - 1);
+
+			dynamics* d = new dynamics(s, false);
+			d->run((long long)checkAmt * beadAmt, beadAmt);
+
+			int length = d->getSeriesLength();
+			int maxLag = (length / 2 < MAX_LAG) ? length / 2 : MAX_LAG;
+			double* acf = new double[(maxLag > 1) ? maxLag : 1];
+			const double* series[2] = {d->getRadiusofGyrationSeries(), 
+									   d->getAsphericitySeries()};
+
+			for(int q = 2; q < 4; q++)
+			{
+				calculateAutocorrelation(series[q - 2], length, acf, maxLag);
+
+				for(int i = 0; i < length; i++)
+				{
+					sum[q] += series[q - 2][i];
+				}
+
+				used[q] = length;
+				independent[q] = length / (2.0 * getIntegratedTime(acf, 
+																	maxLag));
+			}
+
+			used[0] = used[1] = 0.0;
+			delete [] acf;
+			delete d;
+		}
+		else
+		{
+			streamingGrowth grower((engine == 2) ? CHECK_BLOCK_STEPS : 0);
+
+			for(int i = 0; i < checkAmt; i++)
+			{
+				shape result;
+
+				grower.grow(beadAmt - 1, result);
+				sum[0] += result.lamda1;
+				sum[1] += result.lamda2;
+				sum[2] += result.radiusofGyration;
+				sum[3] += result.asphericity;
+			}
+		}
+
+		cout << engines[engine];
+		outputFile << engines[engine];
+
+		for(int q = 0; q < 4; q++)
+		{
+			if(used[q] < 1.0)
+			{
+				cout << setw(10) << "-";
+				outputFile << setw(10) << "-";
+				continue;
+			}
+
+			double error = spreadValues[q] / sqrt(independent[q]);
+			double z = (error > 0.0) 
+					   ? (sum[q] / used[q] - exactValues[q]) / error : 0.0;
+
+			cout << setw(10) << setprecision(3) << z;
+			outputFile << setw(10) << setprecision(3) << z;
+		}
+
+		cout << endl;
+		outputFile << endl;
+	}
+
+	delete s;
+	outputFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputHistogramData                                 *//
+//*                                                                 *//
+//*  Description:  Outputs a datafile for construction a histogram. *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  values:       the quantity of every sample                       //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputHistogramData(int bins, int sampleAmt, sample* s[], int data)
+{
+	double* values = new double[sampleAmt];
+
+	// Build histogram data
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		values[i] = getValueof(data, s[i]);
+	}
+
+	outputHistogramValues(bins, sampleAmt, values, data);
+
+	delete [] values;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputHistogramValues                               *//
+//*                                                                 *//
+//*  Description:  Outputs a histogram datafile from the values of  *//
+//*                a quantity, for runs that keep no samples.       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  MAX_BINS:     max amount of bins                                 //
+//                                                                   //
+//  histInfoFile: output file stream                                 //
+//                                                                   //
+//  range:        array that holds the upper bounds for each bin     //
+//                                                                   //
+//  count:        array that holds the count for each bin            //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputHistogramValues(int bins, int sampleAmt, double values[], 
+						   int data)
+{
+	const int MAX_BINS = 35;
+
+	// Output file stream
+	ofstream histInfoFile;
+
+	double range[MAX_BINS];
+	int count[MAX_BINS];
+
+	polysim_histogram(values, sampleAmt, bins, range, count);
+
+	switch(data)
+	{
+	case ASPHERICITY:
+		histInfoFile.open("AsphericityHistData.txt");
+		break;
+
+	case RADIUSOFGYRATION:
+		histInfoFile.open("ROGHistData.txt");
+		break;
+
+	case LAMDA1:
+		histInfoFile.open("Lamda1HistData.txt");
+		break;
+
+	case LAMDA2:
+		histInfoFile.open("Lamda2HistData.txt");
+		break;
+
+	case CONTACTS:
+		histInfoFile.open("ContactsHistData.txt");
+		break;
+
+	case INTERSECTIONS:
+		histInfoFile.open("OverlapsHistData.txt");
+		break;
+
+	case HULLAREA:
+		histInfoFile.open("HullAreaHistData.txt");
+		break;
+
+	case HULLPERIMETER:
+		histInfoFile.open("HullPerimeterHistData.txt");
+		break;
+
+	case ARMRADIUSOFGYRATION:
+		histInfoFile.open("ArmROGHistData.txt");
+		break;
+
+	case BARRADIUSOFGYRATION:
+		histInfoFile.open("BarROGHistData.txt");
+		break;
+
+	case ARMENDTOEND:
+		histInfoFile.open("ArmEndToEndHistData.txt");
+		break;
+
+	case BRANCHSEPARATION:
+		histInfoFile.open("BranchSeparationHistData.txt");
+		break;
+
+	case ARMANGLE:
+		histInfoFile.open("ArmAngleHistData.txt");
+		break;
+	}
+
+	// Build output
+
+	if(histInfoFile.fail())
+	{
+		cout << "Failed to open histogram file.\n";
+		exit(1);
+	}
+
+	histInfoFile << "Bin\tFrequency\n";
+
+	for(int i = 0; i < bins; i++)
+	{
+		histInfoFile << range[i] << "\t" << count[i] << endl;
+	}
+
+	histInfoFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputStructureFactor                               *//
+//*                                                                 *//
+//*  Description:  Outputs a datafile of the radially binned static *//
+//*                structure factor S(q) averaged over all samples. *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  sf:           structure factor calculator                        //
+//                                                                   //
+//  sfFile:       output file stream                                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputStructureFactor(int sampleAmt, int beadAmt, int beadsX[], 
+						   int beadsY[])
+{
+	structureFactor sf;
+
+	// Output file stream
+	ofstream sfFile;
+
+	sf.calculate(beadsX, beadsY, beadAmt, sampleAmt);
+
+	sfFile.open("StructureFactor.txt");
+
+	if(sfFile.fail())
+	{
+		cout << "Failed to open structure factor file.\n";
+		exit(1);
+	}
+
+	sfFile.setf(ios::fixed);
+	sfFile << "q\tS(q)\tModes\n";
+
+	for(int i = 0; i < sf.getBinCount(); i++)
+	{
+		sfFile << setprecision(6) << sf.getQ(i) << "\t" 
+			   << setprecision(6) << sf.getS(i) << "\t" 
+			   << sf.getModes(i) << endl;
+	}
+
+	sfFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputArmData                                       *//
+//*                                                                 *//
+//*  Description:  Outputs a datafile with a row for every sample   *//
+//*                of the gyration, asphericity and end to end      *//
+//*                distance of each arm, the branch point           *//
+//*                separation and the angles between the arms that  *//
+//*                meet at each branch point.                       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  armFile:      output file stream                                 //
+//                                                                   //
+//  pairs:        the arms each angle column is between              //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputArmData(int sampleAmt, double armData[])
+{
+	// Output file stream
+	ofstream armFile;
+
+	const int pairs[6][2] = {{1, 2}, {1, 3}, {2, 3}, {4, 5}, {3, 4}, 
+							 {3, 5}};
+
+	armFile.open("ArmData.txt");
+
+	if(armFile.fail())
+	{
+		cout << "Failed to open arm data file.\n";
+		exit(1);
+	}
+
+	armFile.setf(ios::fixed);
+
+	for(int a = 1; a <= 5; a++)
+	{
+		armFile << "s^2 " << a << "\t";
+	}
+
+	for(int a = 1; a <= 5; a++)
+	{
+		armFile << "A " << a << "\t";
+	}
+
+	for(int a = 1; a <= 5; a++)
+	{
+		armFile << "R^2 " << a << "\t";
+	}
+
+	armFile << "Branch R";
+
+	for(int p = 0; p < 6; p++)
+	{
+		armFile << "\tAngle " << pairs[p][0] << "-" << pairs[p][1];
+	}
+
+	armFile << endl;
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		double* row = armData + (long long)i * POLYSIM_ARM_VALUES;
+
+		for(int k = 0; k < POLYSIM_ARM_VALUES; k++)
+		{
+			// The end to end distances are whole lattice units
+			armFile << setprecision((k >= 10 && k < 15) ? 0 : 6) 
+					<< row[k] << ((k < POLYSIM_ARM_VALUES - 1) ? "\t" : "");
+		}
+
+		armFile << endl;
+	}
+
+	armFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputPairDistribution                              *//
+//*                                                                 *//
+//*  Description:  Outputs a datafile of the short range pair       *//
+//*                distance distribution p(r), given as the average *//
+//*                number of pairs per bead on each lattice shell.  *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  pairFile:     output file stream                                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputPairDistribution(pairStatistics* pairs)
+{
+	// Output file stream
+	ofstream pairFile;
+
+	pairFile.open("PairDistribution.txt");
+
+	if(pairFile.fail())
+	{
+		cout << "Failed to open pair distribution file.\n";
+		exit(1);
+	}
+
+	pairFile.setf(ios::fixed);
+	pairFile << "r\tp(r)\n";
+
+	for(int i = 0; i < PAIR_SHELLS; i++)
+	{
+		if(pairs->isShell(i))
+		{
+			pairFile << setprecision(6) << pairs->getDistance(i) << "\t" 
+				     << setprecision(6) << pairs->getPairs(i) << endl;
+		}
+	}
+
+	pairFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputScalingData                                   *//
+//*                                                                 *//
+//*  Description:  Outputs a datafile of every checkpoint of a      *//
+//*                scaling trajectory with the fitted exponent.     *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  scalingFile:  output file stream                                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputScalingData(scalingTrajectory* trajectory)
+{
+	// Output file stream
+	ofstream scalingFile;
+
+	scalingFile.open("ScalingData.txt");
+
+	if(scalingFile.fail())
+	{
+		cout << "Failed to open scaling file.\n";
+		exit(1);
+	}
+
+	scalingFile.setf(ios::fixed);
+	scalingFile << "2D H-Comb Polymer Simulation" << "\n\n";
+	scalingFile << "Samples: " << trajectory->getSampleCount() << endl;
+	scalingFile << "nu: " << setprecision(6) << trajectory->getExponent() 
+		        << " +/- " << setprecision(6) 
+				<< trajectory->getExponentError() << endl << endl;
+
+	scalingFile << "N\tLamda1\tsdLamda1\tLamda2\tsdLamda2" 
+		        << "\ts^2\tsds^2\tA\tsdA\n";
+
+	for(int c = 0; c < trajectory->getCheckpointCount(); c++)
+	{
+		scalingFile << trajectory->getBeads(c) << "\t" 
+			        << setprecision(6) << trajectory->getLamda1(c) << "\t" 
+			        << setprecision(6) << trajectory->getSdLamda1(c) << "\t" 
+			        << setprecision(6) << trajectory->getLamda2(c) << "\t" 
+			        << setprecision(6) << trajectory->getSdLamda2(c) << "\t" 
+			        << setprecision(6) 
+					<< trajectory->getRadiusofGyration(c) << "\t" 
+			        << setprecision(6) 
+					<< trajectory->getSdRadiusofGyration(c) << "\t" 
+			        << setprecision(6) << trajectory->getAsphericity(c) 
+					<< "\t" 
+			        << setprecision(6) << trajectory->getSdAsphericity(c) 
+					<< endl;
+	}
+
+	scalingFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputDynamicsData                                  *//
+//*                                                                 *//
+//*  Description:  Outputs the time series of a dynamics run and    *//
+//*                the autocorrelation functions of s^2 and A.      *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  seriesFile:   time series output file stream                     //
+//                                                                   //
+//  acfFile:      autocorrelation output file stream                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputDynamicsData(dynamics* d, double* acfRadiusofGyration, 
+						double* acfAsphericity, int maxLag)
+{
+	// Output file streams
+	ofstream seriesFile, acfFile;
+
+	seriesFile.open("DynamicsSeries.txt");
+
+	if(seriesFile.fail())
+	{
+		cout << "Failed to open dynamics series file.\n";
+		exit(1);
+	}
+
+	seriesFile.setf(ios::fixed);
+	seriesFile << "Moves\ts^2\tA\n";
+
+	for(int i = 0; i < d->getSeriesLength(); i++)
+	{
+		seriesFile << (long long)i * d->getRecordInterval() << "\t" 
+			       << setprecision(6) 
+				   << d->getRadiusofGyrationSeries()[i] << "\t" 
+			       << setprecision(6) 
+				   << d->getAsphericitySeries()[i] << endl;
+	}
+
+	seriesFile.close();
+
+	acfFile.open("Autocorrelation.txt");
+
+	if(acfFile.fail())
+	{
+		cout << "Failed to open autocorrelation file.\n";
+		exit(1);
+	}
+
+	acfFile.setf(ios::fixed);
+	acfFile << "Lag\tC(s^2)\tC(A)\n";
+
+	for(int i = 0; i < maxLag; i++)
+	{
+		acfFile << (long long)i * d->getRecordInterval() << "\t" 
+			    << setprecision(6) << acfRadiusofGyration[i] << "\t" 
+			    << setprecision(6) << acfAsphericity[i] << endl;
+	}
+
+	acfFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputDensityOfStates                               *//
+//*                                                                 *//
+//*  Description:  Outputs ln g and the average s^2 and A at every  *//
+//*                contact count, everything needed to reweight to  *//
+//*                any temperature later.                           *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  dosFile:      output file stream                                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputDensityOfStates(wangLandau* wl)
+{
+	// Output file stream
+	ofstream dosFile;
+
+	dosFile.open("DensityOfStates.txt");
+
+	if(dosFile.fail())
+	{
+		cout << "Failed to open density of states file.\n";
+		exit(1);
+	}
+
+	dosFile.setf(ios::fixed);
+	dosFile << "2D H-Comb Polymer Simulation" << "\n\n";
+	dosFile << "Beads: " << wl->getBeadCount() << endl;
+	dosFile << "Energy = -Contacts, ln g(0) = 0" << endl << endl;
+
+	dosFile << "Contacts\tln g\tSamples\ts^2\tA\n";
+
+	for(int m = 0; m <= wl->getMaxContacts(); m++)
+	{
+		if(wl->isReached(m))
+		{
+			dosFile << m << "\t" 
+				    << setprecision(6) << wl->getLnG(m) << "\t" 
+				    << wl->getSampleCount(m) << "\t" 
+				    << setprecision(6) 
+				    << wl->getAverageRadiusofGyration(m) << "\t" 
+				    << setprecision(6) 
+				    << wl->getAverageAsphericity(m) << endl;
+		}
+	}
+
+	dosFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  outputThermodynamics                                *//
+//*                                                                 *//
+//*  Description:  Outputs the energy, heat capacity, s^2 and A     *//
+//*                reweighted to every temperature step.            *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+//// Variables ////////////////////////////////////////////////////////
+//                                                                   //
+//  thermoFile:   output file stream                                 //
+//                                                                   //
+///////////////////////////////////////////////////////////////////////
+void outputThermodynamics(wangLandau* wl)
+{
+	// Output file stream
+	ofstream thermoFile;
+
+	thermoFile.open("Thermodynamics.txt");
+
+	if(thermoFile.fail())
+	{
+		cout << "Failed to open thermodynamics file.\n";
+		exit(1);
+	}
+
+	thermoFile.setf(ios::fixed);
+	thermoFile << "T\tE\tC\ts^2\tA\n";
+
+	for(double t = TEMPERATURE_STEP; t <= TEMPERATURE_MAX + 1e-9; 
+		t += TEMPERATURE_STEP)
+	{
+		double energy, heatCapacity, radiusofGyration, asphericity;
+
+		wl->reweight(t, energy, heatCapacity, radiusofGyration, 
+					 asphericity);
+
+		thermoFile << setprecision(2) << t << "\t" 
+			       << setprecision(6) << energy << "\t" 
+			       << setprecision(6) << heatCapacity << "\t" 
+			       << setprecision(6) << radiusofGyration << "\t" 
+			       << setprecision(6) << asphericity << endl;
+	}
+
+	thermoFile.close();
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getIntegratedTime                                   *//
+//*                                                                 *//
+//*  Description:  Returns the integrated autocorrelation time, in  *//
+//*                points of the series, summing the normalised     *//
+//*                autocorrelation until it first drops to zero.    *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getIntegratedTime(double* acf, int maxLag)
+{
+	double tau = 0.5;
+
+	for(int i = 1; i < maxLag; i++)
+	{
+		if(acf[i] <= 0.0)
+		{
+			break;
+		}
+
+		tau += acf[i];
+	}
+
+	return tau;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getValueof                                          *//
+//*                                                                 *//
+//*  Description:  Returns one quantity of a sample.                *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getValueof(int data, sample* s)
+{
+	switch(data)
+	{
+	case ASPHERICITY:
+		return s->getAsphericity();
+
+	case RADIUSOFGYRATION:
+		return s->getRadiusofGyration();
+
+	case LAMDA1:
+		return s->getLamda1();
+
+	case LAMDA2:
+		return s->getLamda2();
+
+	case CONTACTS:
+		return s->getContacts();
+
+	case INTERSECTIONS:
+		return s->getSelfIntersections();
+
+	case HULLAREA:
+		return s->getHullArea();
+
+	case HULLPERIMETER:
+		return s->getHullPerimeter();
+
+	case ARMRADIUSOFGYRATION:
+		return (s->getArmRadiusofGyration(1) + s->getArmRadiusofGyration(2)
+				+ s->getArmRadiusofGyration(4) 
+				+ s->getArmRadiusofGyration(5)) / 4;
+
+	case BARRADIUSOFGYRATION:
+		return s->getArmRadiusofGyration(3);
+
+	case ARMENDTOEND:
+		return (s->getArmEndToEnd(1) + s->getArmEndToEnd(2) 
+				+ s->getArmEndToEnd(4) + s->getArmEndToEnd(5)) / 4;
+
+	case BRANCHSEPARATION:
+		return s->getBranchSeparation();
+
+	case ARMANGLE:
+		return (s->getArmAngle(1, 2) + s->getArmAngle(4, 5)) / 2;
+	}
+
+	return 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getAverageof                                        *//
+//*                                                                 *//
+//*  Description:  Returns the average of a quantity over a set of  *//
+//*                samples.                                         *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getAverageof(int data, sample* s[], int sampleAmt)
+{
+	double sum = 0.0;
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		sum += getValueof(data, s[i]);
+	}
+
+	return sum / sampleAmt;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getDeviationof                                      *//
+//*                                                                 *//
+//*  Description:  Returns the standard deviation of the mean of a  *//
+//*                quantity over a set of samples, worked out the   *//
+//*                same way as for a set of values.                 *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getDeviationof(int data, sample* s[], int sampleAmt)
+{
+	double sum = 0.0, sum2 = 0.0, avg, avgSq;
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		sum += getValueof(data, s[i]);
+		sum2 += pow(getValueof(data, s[i]), 2.0);
+	}
+
+	avg = sum / sampleAmt;
+	avgSq = sum2 / sampleAmt;
+
+	return sqrt((avgSq - avg * avg) / (sampleAmt - 1));
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getAverageof                                        *//
+//*                                                                 *//
+//*  Description:  Returns the average of a set of values.          *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getAverageof(double values[], int sampleAmt)
+{
+	double sum = 0.0;
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		sum += values[i];
+	}
+
+	return sum / sampleAmt;
+}
+
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  Function:  getDeviationof                                      *//
+//*                                                                 *//
+//*  Description:  Returns the standard deviation of the mean of a  *//
+//*                set of values.                                   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+double getDeviationof(double values[], int sampleAmt)
+{
+	double sum = 0.0, sum2 = 0.0, avg, avgSq;
+
+	for(int i = 0; i < sampleAmt; i++)
+	{
+		sum += values[i];
+		sum2 += pow(values[i], 2.0);
+	}
+
+	avg = sum / sampleAmt;
+	avgSq = sum2 / sampleAmt;
+
+	return sqrt((avgSq - avg * avg) / (sampleAmt - 1));
 }
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      moments.cpp                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the running gyration       *//
+//*  moments. The shape is worked out the same way as in sample,    *//
+//*  only from the sums instead of from the bead arrays.            *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include "moments.h"
+
+// Empties a set of moments
+//
+void clearMoments(moments& m)
+{
+	m.n = 0;
+	m.sx = 0;
+	m.sy = 0;
+	m.sxx = 0;
+	m.sxy = 0;
+	m.syy = 0;
+}
+
+// Adds a bead at x, y
+//
+void addPoint(moments& m, int x, int y)
+{
+	m.n++;
+	m.sx += x;
+	m.sy += y;
+	m.sxx += (long long)x * x;
+	m.sxy += (long long)x * y;
+	m.syy += (long long)y * y;
+}
+
+// Takes away a bead at x, y
+//
+void removePoint(moments& m, int x, int y)
+{
+	m.n--;
+	m.sx -= x;
+	m.sy -= y;
+	m.sxx -= (long long)x * x;
+	m.sxy -= (long long)x * y;
+	m.syy -= (long long)y * y;
+}
+
+// Adds the moments of another set of beads after moving all of them
+// by dx, dy. This lets a piece of the molecule be kept relative to
+// its own anchor and placed later.
+//
+void addMoments(moments& to, const moments& from, int dx, int dy)
+{
+	to.n += from.n;
+	to.sx += from.sx + from.n * dx;
+	to.sy += from.sy + from.n * dy;
+	to.sxx += from.sxx + 2 * dx * from.sx + from.n * dx * dx;
+	to.sxy += from.sxy + dx * from.sy + dy * from.sx + from.n * dx * dy;
+	to.syy += from.syy + 2 * dy * from.sy + from.n * dy * dy;
+}
+
+// Works out lamda1, lamda2, s^2 and A from a set of moments
+//
+void calculateShape(const moments& m, shape& result)
+{
+	double n = (double)m.n;
+	double xcm = m.sx / n, ycm = m.sy / n;
+
+	calculateTensorShape(m.sxx / n - xcm * xcm, m.sxy / n - xcm * ycm, 
+						 m.syy / n - ycm * ycm, result);
+}
+
+// Works out lamda1, lamda2, s^2 and A from the gyration tensor
+//
+void calculateTensorShape(double t11, double t12, double t22, 
+						  shape& result)
+{
+	double factor;
+
+	// Written as a square so rounding can never take it below zero
+	factor = (1.0 / 2) * sqrt(((t11 - t22) * (t11 - t22)) 
+							  + (4 * (t12 * t12)));
+
+	result.lamda1 = ((t11 + t22) / 2) + factor;
+	result.lamda2 = ((t11 + t22) / 2) - factor;
+	result.radiusofGyration = result.lamda1 + result.lamda2;
+	result.asphericity = pow((result.lamda1 - result.lamda2), 2.0)
+		                 / pow((result.lamda2 + result.lamda1), 2.0);
+}
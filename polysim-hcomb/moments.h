@@ -0,0 +1,35 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      moments.h                                           *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the running gyration moments.                  *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+
+// The running sums the gyration tensor is built from. Lattice
+// coordinates are integers so the sums are kept exactly and can be
+// added to, taken from or shifted without ever touching the beads.
+struct moments{
+	long long n;
+	long long sx, sy;
+	long long sxx, sxy, syy;
+};
+
+// The four shape quantities the program reports for a sample
+struct shape{
+	double lamda1;
+	double lamda2;
+	double radiusofGyration;
+	double asphericity;
+};
+
+// Functionality
+void clearMoments(moments& m);
+void addPoint(moments& m, int x, int y);
+void removePoint(moments& m, int x, int y);
+void addMoments(moments& to, const moments& from, int dx, int dy);
+void calculateShape(const moments& m, shape& result);
+void calculateTensorShape(double t11, double t12, double t22, 
+						  shape& result);
@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      occupancy.cpp                                       *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the occupancyGrid class.   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include "occupancy.h"
+
+// Constructor for an occupancy grid that can hold up to capacity
+// occupied sites at once.
+//
+occupancyGrid::occupancyGrid(int capacity)
+{
+	this->capacity = capacity;
+	hashSize = 1;
+
+	while(hashSize < 2 * capacity)
+	{
+		hashSize = hashSize * 2;
+	}
+
+	bucketHead = new int[hashSize];
+	nodeX = new int[capacity];
+	nodeY = new int[capacity];
+	nodeCount = new int[capacity];
+	nodeNext = new int[capacity];
+
+	clear();
+}
+
+// Destructor for an occupancy grid.
+//
+occupancyGrid::~occupancyGrid(void)
+{
+	delete [] bucketHead;
+	delete [] nodeX;
+	delete [] nodeY;
+	delete [] nodeCount;
+	delete [] nodeNext;
+}
+
+// Empties every site
+//
+void occupancyGrid::clear()
+{
+	for(int i = 0; i < hashSize; i++)
+	{
+		bucketHead[i] = -1;
+	}
+
+	// Chain every node onto the free list
+	for(int i = 0; i < capacity; i++)
+	{
+		nodeNext[i] = i + 1;
+	}
+
+	if(capacity > 0)
+	{
+		nodeNext[capacity - 1] = -1;
+	}
+
+	freeNode = (capacity > 0) ? 0 : -1;
+}
+
+// Returns the bucket a site lands in
+//
+int occupancyGrid::hashSite(int x, int y)
+{
+	unsigned int h = (unsigned int)x * 73856093u
+		             ^ (unsigned int)y * 19349663u;
+
+	return (int)(h & (unsigned int)(hashSize - 1));
+}
+
+// Returns the node of a site or -1 when nothing is there
+//
+int occupancyGrid::findNode(int x, int y)
+{
+	for(int i = bucketHead[hashSite(x, y)]; i != -1; i = nodeNext[i])
+	{
+		if(nodeX[i] == x && nodeY[i] == y)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// Puts a bead on a site
+//
+void occupancyGrid::add(int x, int y)
+{
+	int i = findNode(x, y);
+
+	if(i == -1)
+	{
+		int bucket = hashSite(x, y);
+
+		i = freeNode;
+		freeNode = nodeNext[i];
+		nodeX[i] = x;
+		nodeY[i] = y;
+		nodeCount[i] = 0;
+		nodeNext[i] = bucketHead[bucket];
+		bucketHead[bucket] = i;
+	}
+
+	nodeCount[i]++;
+}
+
+// Takes a bead off a site. The node goes back on the free list once
+// the site is empty.
+//
+void occupancyGrid::remove(int x, int y)
+{
+	int bucket = hashSite(x, y), previous = -1;
+
+	for(int i = bucketHead[bucket]; i != -1; i = nodeNext[i])
+	{
+		if(nodeX[i] == x && nodeY[i] == y)
+		{
+			nodeCount[i]--;
+
+			if(nodeCount[i] == 0)
+			{
+				if(previous == -1)
+				{
+					bucketHead[bucket] = nodeNext[i];
+				}
+				else
+				{
+					nodeNext[previous] = nodeNext[i];
+				}
+
+				nodeNext[i] = freeNode;
+				freeNode = i;
+			}
+
+			return;
+		}
+
+		previous = i;
+	}
+}
+
+// Returns the number of beads on a site
+//
+int occupancyGrid::count(int x, int y)
+{
+	int i = findNode(x, y);
+
+	return (i == -1) ? 0 : nodeCount[i];
+}
+
+// Returns the number of beads on the four sites around a site
+//
+int occupancyGrid::countNeighbours(int x, int y)
+{
+	return count(x + 1, y) + count(x - 1, y)
+		   + count(x, y + 1) + count(x, y - 1);
+}
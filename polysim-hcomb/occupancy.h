@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      occupancy.h                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the occupancyGrid class.                       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Counts how many beads sit on each lattice site. Only occupied
+// sites are stored, in a hash with one node per site, so the grid
+// follows a chain wherever it wanders at O(1) per lookup and never
+// needs more nodes than there are beads.
+class occupancyGrid
+{
+private:
+	int hashSize, capacity, freeNode;
+	int* bucketHead;
+	int* nodeX;
+	int* nodeY;
+	int* nodeCount;
+	int* nodeNext;
+
+	int hashSite(int x, int y);
+	int findNode(int x, int y);
+
+public:
+	// Constructor and destructor
+	occupancyGrid(int capacity);
+	~occupancyGrid(void);
+
+	// Functionality
+	void clear();
+	void add(int x, int y);
+	void remove(int x, int y);
+	int count(int x, int y);
+	int countNeighbours(int x, int y);
+};
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      offlattice.cpp                                      *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the offLatticeGrowth       *//
+//*  class. Bond directions are drawn for the whole sample first    *//
+//*  and turned into bond vectors in one batch, so no per bead      *//
+//*  library trig calls are made.                                   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <math.h>
+#include "offlattice.h"
+#include "fastmath.h"
+
+const double PI = 3.14159265358979323846;
+
+// Constructor for an off lattice grower. A stiffness too small to
+// bend a bond measurably is taken as freely jointed, and the
+// Best-Fisher constant is worked out once for the rest.
+//
+offLatticeGrowth::offLatticeGrowth(double stiffness)
+{
+	this->stiffness = (stiffness > MIN_STIFFNESS) ? stiffness : 0.0;
+	bendR = 0.0;
+
+	if(this->stiffness > 0.0)
+	{
+		// rho = (tau - sqrt(2 tau)) / (2 stiffness) with both
+		// differences rewritten so nothing cancels at small stiffness
+		double k = this->stiffness;
+		double root = sqrt(1.0 + 4.0 * k * k);
+		double tau = 1.0 + root;
+		double tauLessTwo = 4.0 * k * k / (root + 1.0);
+		double rho = tau * tauLessTwo / (tau + sqrt(2.0 * tau)) / (2.0 * k);
+
+		bendR = (1.0 + rho * rho) / (2.0 * rho);
+	}
+}
+
+// Destructor for an off lattice grower.
+//
+offLatticeGrowth::~offLatticeGrowth(void)
+{
+
+}
+
+// Returns a uniform random number in [0, 1). Two calls to rand are
+// joined since RAND_MAX can be as small as 32767.
+//
+double offLatticeGrowth::randomUniform()
+{
+	double range = RAND_MAX + 1.0;
+
+	return (rand() * range + rand()) / (range * range);
+}
+
+// Draws a bend for every wormlike bond from the von Mises
+// distribution exp(stiffness * cos) with the Best-Fisher method and
+// keeps its cosine and sine. Every pending bond gets a proposal in
+// one batch, the rejected ones are packed to the front, and only they
+// are tried again.
+//
+void offLatticeGrowth::drawBends(int pending)
+{
+	while(pending > 0)
+	{
+		int rejected = 0;
+
+		for(int j = 0; j < pending; j++)
+		{
+			angle[j] = PI * randomUniform();
+		}
+
+		fastSinCosBatch(angle, drawSin, drawCos, pending);
+
+		for(int j = 0; j < pending; j++)
+		{
+			int k = pendingBend[j];
+			double z = drawCos[j];
+			double f = (1.0 + bendR * z) / (bendR + z);
+			double c = stiffness * (bendR - f);
+			double u = randomUniform();
+
+			if(c * (2.0 - c) - u > 0.0
+				|| (u > 0.0 && log(c / u) + 1.0 - c >= 0.0))
+			{
+				if(f > 1.0)
+				{
+					f = 1.0;
+				}
+				else if(f < -1.0)
+				{
+					f = -1.0;
+				}
+
+				bendCos[k] = f;
+				bendSin[k] = (randomUniform() < 0.5) ? -sqrt(1.0 - f * f)
+					                                 : sqrt(1.0 - f * f);
+			}
+			else
+			{
+				pendingBend[rejected] = k;
+				rejected++;
+			}
+		}
+
+		pending = rejected;
+	}
+}
+
+// Grows a sample of amount bonds off the lattice and hands its
+// gyration tensor to the sample.
+//
+void offLatticeGrowth::grow(sample* s, int amount)
+{
+	int armLength = amount / 5, star = amount - (armLength * 2);
+	bool started[5] = {false, false, false, false, false};
+	int lastBond[5];
+	int bends = 0;
+	double headX[5], headY[5];
+
+	// Work out which arm every bond belongs to, in the same order
+	// addBeads grows them, and draw the free directions.
+	for(int k = 0; k < amount; k++)
+	{
+		int arm = (k < star) ? k % 3 : 3 + (k - star) % 2;
+
+		bondArm[k] = arm;
+		firstBond[k] = !started[arm];
+		started[arm] = true;
+
+		if(firstBond[k] || stiffness == 0.0)
+		{
+			angle[k] = 2.0 * PI * randomUniform();
+		}
+		else
+		{
+			angle[k] = 0.0;
+			pendingBend[bends] = k;
+			bends++;
+		}
+	}
+
+	fastSinCosBatch(angle, bondY, bondX, amount);
+
+	// A wormlike bond is the bond before it on its arm turned by the
+	// bend, done as a rotation so no angle has to be taken back out.
+	if(bends > 0)
+	{
+		drawBends(bends);
+
+		for(int k = 0; k < amount; k++)
+		{
+			int arm = bondArm[k];
+
+			if(!firstBond[k])
+			{
+				double px = bondX[lastBond[arm]], py = bondY[lastBond[arm]];
+
+				bondX[k] = px * bendCos[k] - py * bendSin[k];
+				bondY[k] = px * bendSin[k] + py * bendCos[k];
+			}
+
+			lastBond[arm] = k;
+		}
+	}
+
+	// Lay the beads down. Arms 4 and 5 start at the head of arm 3.
+	for(int a = 0; a < 5; a++)
+	{
+		headX[a] = 0.0;
+		headY[a] = 0.0;
+	}
+
+	beadsX[0] = 0.0;
+	beadsY[0] = 0.0;
+
+	for(int k = 0; k < amount; k++)
+	{
+		int arm = bondArm[k];
+
+		if(k == star)
+		{
+			headX[3] = headX[2];
+			headY[3] = headY[2];
+			headX[4] = headX[2];
+			headY[4] = headY[2];
+		}
+
+		headX[arm] += bondX[k];
+		headY[arm] += bondY[k];
+		beadsX[k + 1] = headX[arm];
+		beadsY[k + 1] = headY[arm];
+	}
+
+	// Gyration tensor, the same two passes sample uses
+	int beads = amount + 1;
+	double xcm = 0.0, ycm = 0.0, t11 = 0.0, t12 = 0.0, t22 = 0.0;
+
+	for(int i = 0; i < beads; i++)
+	{
+		xcm += beadsX[i];
+		ycm += beadsY[i];
+	}
+
+	xcm = xcm / beads;
+	ycm = ycm / beads;
+
+	for(int i = 0; i < beads; i++)
+	{
+		double dx = beadsX[i] - xcm, dy = beadsY[i] - ycm;
+
+		t11 += dx * dx;
+		t12 += dx * dy;
+		t22 += dy * dy;
+	}
+
+	s->setTensor(xcm, ycm, t11 / beads, t12 / beads, t22 / beads);
+}
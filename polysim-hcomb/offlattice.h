@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      offlattice.h                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the offLatticeGrowth class.                    *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+
+// Stiffness below which bonds are taken as freely jointed
+const double MIN_STIFFNESS = 1e-6;
+
+// Grows H-Combs off the lattice with unit bonds in the same arm order
+// addBeads uses. With a stiffness of zero (or under MIN_STIFFNESS)
+// every bond points in a uniformly random direction (freely jointed).
+// Otherwise each bond
+// bends away from the one before it on its arm with probability
+// proportional to exp(stiffness * cos(bend)) (wormlike). The first
+// bond of every arm is always free.
+//
+// Coordinates are kept in double SoA buffers owned by the grower and
+// reused for every sample. Only the gyration tensor is handed to the
+// sample, which works out its shape from there.
+class offLatticeGrowth
+{
+private:
+	double stiffness;
+	double bendR;
+	double angle[MAX_BEADS];
+	double bondX[MAX_BEADS];
+	double bondY[MAX_BEADS];
+	double beadsX[MAX_BEADS];
+	double beadsY[MAX_BEADS];
+	int bondArm[MAX_BEADS];
+	bool firstBond[MAX_BEADS];
+	double bendCos[MAX_BEADS];
+	double bendSin[MAX_BEADS];
+	double drawSin[MAX_BEADS];
+	double drawCos[MAX_BEADS];
+	int pendingBend[MAX_BEADS];
+
+	double randomUniform();
+	void drawBends(int pending);
+
+public:
+	// Constructor and destructor
+	offLatticeGrowth(double stiffness);
+	~offLatticeGrowth(void);
+
+	// Functionality
+	void grow(sample* s, int amount);
+};
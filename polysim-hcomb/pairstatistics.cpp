@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      pairstatistics.cpp                                  *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the pairStatistics class.  *//
+//*  Beads are hashed into cells so finding every pair closer than  *//
+//*  PAIR_RANGE costs O(N) instead of the O(N^2) double loop.       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include "pairstatistics.h"
+
+// Constructor for the pair statistics. The hash has at least twice
+// as many buckets as there can be beads so chains stay short.
+//
+pairStatistics::pairStatistics(void)
+{
+	hashSize = 1;
+
+	while(hashSize < 2 * MAX_BEADS)
+	{
+		hashSize = hashSize * 2;
+	}
+
+	bucketHead = new int[hashSize];
+
+	for(int i = 0; i < hashSize; i++)
+	{
+		bucketHead[i] = -1;
+	}
+
+	for(int i = 0; i < PAIR_SHELLS; i++)
+	{
+		pairSum[i] = 0.0;
+	}
+
+	sampleCount = 0;
+}
+
+// Destructor for the pair statistics.
+//
+pairStatistics::~pairStatistics(void)
+{
+	delete [] bucketHead;
+}
+
+// Returns the bucket a cell lands in
+//
+int pairStatistics::hashCell(int cx, int cy)
+{
+	unsigned int h = (unsigned int)cx * 73856093u
+		             ^ (unsigned int)cy * 19349663u;
+
+	return (int)(h & (unsigned int)(hashSize - 1));
+}
+
+// Counts the non-bonded nearest neighbour contacts and the self
+// intersections (pairs of beads on the same site) of a sample, stores
+// them in the sample and adds its pair distances to p(r).
+//
+void pairStatistics::addSample(sample* s)
+{
+	int beads = s->getBeadCount();
+	int minX = 0, minY = 0;
+	int contacts = 0, selfIntersections = 0;
+	int shells[PAIR_SHELLS];
+
+	for(int i = 0; i < PAIR_SHELLS; i++)
+	{
+		shells[i] = 0;
+	}
+
+	for(int i = 0; i < beads; i++)
+	{
+		if(s->getBeadX(i) < minX)
+		{
+			minX = s->getBeadX(i);
+		}
+
+		if(s->getBeadY(i) < minY)
+		{
+			minY = s->getBeadY(i);
+		}
+	}
+
+	// Hash every bead into its cell
+	for(int i = 0; i < beads; i++)
+	{
+		cellX[i] = (s->getBeadX(i) - minX) / PAIR_RANGE;
+		cellY[i] = (s->getBeadY(i) - minY) / PAIR_RANGE;
+
+		int bucket = hashCell(cellX[i], cellY[i]);
+		nextBead[i] = bucketHead[bucket];
+		bucketHead[bucket] = i;
+	}
+
+	// Every pair closer than PAIR_RANGE sits in the 3x3 block of
+	// cells around either bead. Only j > i is counted so each pair
+	// is seen once, and other cells sharing a bucket are skipped.
+	for(int i = 0; i < beads; i++)
+	{
+		int x = s->getBeadX(i), y = s->getBeadY(i);
+		int bonded = s->getBondedBead(i);
+
+		for(int dy = -1; dy <= 1; dy++)
+		{
+			for(int dx = -1; dx <= 1; dx++)
+			{
+				int cx = cellX[i] + dx, cy = cellY[i] + dy;
+
+				if(cx < 0 || cy < 0)
+				{
+					continue;
+				}
+
+				for(int j = bucketHead[hashCell(cx, cy)]; j != -1;
+					j = nextBead[j])
+				{
+					if(j <= i || cellX[j] != cx || cellY[j] != cy)
+					{
+						continue;
+					}
+
+					int rx = s->getBeadX(j) - x, ry = s->getBeadY(j) - y;
+					int r2 = rx * rx + ry * ry;
+
+					if(r2 >= PAIR_SHELLS)
+					{
+						continue;
+					}
+
+					shells[r2]++;
+
+					if(r2 == 0)
+					{
+						selfIntersections++;
+					}
+					else if(r2 == 1 && bonded != j
+						    && s->getBondedBead(j) != i)
+					{
+						contacts++;
+					}
+				}
+			}
+		}
+	}
+
+	// Empty the buckets again for the next sample
+	for(int i = 0; i < beads; i++)
+	{
+		bucketHead[hashCell(cellX[i], cellY[i])] = -1;
+	}
+
+	for(int i = 0; i < PAIR_SHELLS; i++)
+	{
+		pairSum[i] += (double)shells[i] / beads;
+	}
+
+	sampleCount++;
+
+	s->setContacts(contacts);
+	s->setSelfIntersections(selfIntersections);
+}
+
+// Below this point are all get functions
+int pairStatistics::getSampleCount()
+{
+	return sampleCount;
+}
+
+// Returns true when r^2 = shell is a distance the lattice can have
+bool pairStatistics::isShell(int shell)
+{
+	for(int a = 0; a * a <= shell; a++)
+	{
+		int b = (int)(sqrt((double)(shell - a * a)) + 0.5);
+
+		if(a * a + b * b == shell)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+double pairStatistics::getDistance(int shell)
+{
+	return sqrt((double)shell);
+}
+
+// Returns the average number of pairs per bead at distance r
+double pairStatistics::getPairs(int shell)
+{
+	if(sampleCount == 0)
+	{
+		return 0.0;
+	}
+
+	return pairSum[shell] / sampleCount;
+}
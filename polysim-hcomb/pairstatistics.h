@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      pairstatistics.h                                    *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the pairStatistics class.                      *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+
+// Defines the largest pair distance counted in p(r). This is also
+// the side of a cell in the spatial hash.
+const int PAIR_RANGE = 6;
+
+// Defines the number of lattice shells r^2 = 0 .. PAIR_RANGE^2
+const int PAIR_SHELLS = PAIR_RANGE * PAIR_RANGE + 1;
+
+// Counts short range pairs of a sample in O(N) by hashing every bead
+// into a cell of side PAIR_RANGE and only looking at the 3x3 block of
+// cells around each bead. Contacts and self intersections are stored
+// back into the sample, p(r) is summed over the whole ensemble.
+class pairStatistics
+{
+private:
+	int hashSize;
+	int* bucketHead;
+	int nextBead[MAX_BEADS];
+	int cellX[MAX_BEADS];
+	int cellY[MAX_BEADS];
+	double pairSum[PAIR_SHELLS];
+	int sampleCount;
+
+	int hashCell(int cx, int cy);
+
+public:
+	// Constructor and destructor
+	pairStatistics(void);
+	~pairStatistics(void);
+
+	// Functionality
+	void addSample(sample* s);
+
+	// Gets and sets
+	int getSampleCount();
+	bool isShell(int shell);
+	double getDistance(int shell);
+	double getPairs(int shell);
+};
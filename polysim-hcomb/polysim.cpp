@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      polysim.cpp                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the C interface. A run     *//
+//*  owns one sample that is reset and regrown for every result, so *//
+//*  generating costs no allocation at all.                         *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "polysim.h"
+#include "sample.h"
+#include "pairstatistics.h"
+#include "convexhull.h"
+
+// Bumped whenever results for the same configuration could change
+const char* const POLYSIM_VERSION = "1.1.0";
+
+// Angles written into armData, in order
+const int ARM_ANGLES[6][2] = {{1, 2}, {1, 3}, {2, 3}, {4, 5}, {3, 4}, 
+							  {3, 5}};
+
+struct polysim_run{
+	polysim_config config;
+	sample workspace;
+	pairStatistics pairs;
+	convexHull hull;
+};
+
+// Returns the version of the library
+//
+const char* polysim_version(void)
+{
+	return POLYSIM_VERSION;
+}
+
+// Fills in a configuration with the values the interactive program
+// would start from.
+//
+void polysim_default_config(polysim_config* config)
+{
+	if(config == NULL)
+	{
+		return;
+	}
+
+	config->beadAmount = 100;
+	config->seed = 0;
+}
+
+// Makes a run. Returns NULL if the configuration is not usable or
+// there is not enough memory. No exception gets out to the caller.
+//
+polysim_run* polysim_create(const polysim_config* config)
+{
+	if(config == NULL || config->beadAmount < 1
+		|| config->beadAmount > MAX_BEADS)
+	{
+		return NULL;
+	}
+
+	polysim_run* run = NULL;
+
+	try
+	{
+		run = new polysim_run;
+	}
+	catch(...)
+	{
+		return NULL;
+	}
+
+	run->config = *config;
+
+	// Every run has a generator of its own, so runs never share or
+	// disturb each other's random numbers
+	unsigned long long seed = config->seed;
+
+	if(seed == 0)
+	{
+		for(int k = 0; k < 4; k++)
+		{
+			seed = (seed << 16) ^ (unsigned long long)rand();
+		}
+	}
+
+	run->workspace.setSeed((seed != 0) ? seed : 1);
+
+	return run;
+}
+
+// Frees a run
+//
+void polysim_destroy(polysim_run* run)
+{
+	delete run;
+}
+
+// Writes whichever arm and branch point quantities of a sample the
+// caller asked for into index i of its arrays.
+//
+static void writeArms(sample* s, const polysim_results* results, int i)
+{
+	if(results->armRadiusOfGyration != NULL)
+	{
+		results->armRadiusOfGyration[i] = (s->getArmRadiusofGyration(1) 
+			+ s->getArmRadiusofGyration(2) + s->getArmRadiusofGyration(4) 
+			+ s->getArmRadiusofGyration(5)) / 4;
+	}
+
+	if(results->barRadiusOfGyration != NULL)
+	{
+		results->barRadiusOfGyration[i] = s->getArmRadiusofGyration(3);
+	}
+
+	if(results->armEndToEnd != NULL)
+	{
+		results->armEndToEnd[i] = (s->getArmEndToEnd(1) 
+			+ s->getArmEndToEnd(2) + s->getArmEndToEnd(4) 
+			+ s->getArmEndToEnd(5)) / 4;
+	}
+
+	if(results->branchSeparation != NULL)
+	{
+		results->branchSeparation[i] = s->getBranchSeparation();
+	}
+
+	if(results->armAngle != NULL)
+	{
+		results->armAngle[i] = (s->getArmAngle(1, 2) 
+			+ s->getArmAngle(4, 5)) / 2;
+	}
+
+	if(results->armData != NULL)
+	{
+		double* row = results->armData + (long long)i * POLYSIM_ARM_VALUES;
+
+		for(int a = 1; a <= 5; a++)
+		{
+			row[a - 1] = s->getArmRadiusofGyration(a);
+			row[a + 4] = s->getArmAsphericity(a);
+			row[a + 9] = s->getArmEndToEnd(a);
+		}
+
+		row[15] = s->getBranchSeparation();
+
+		for(int p = 0; p < 6; p++)
+		{
+			row[16 + p] = s->getArmAngle(ARM_ANGLES[p][0], 
+										 ARM_ANGLES[p][1]);
+		}
+	}
+}
+
+// Grows count samples and writes their quantities into the caller's
+// arrays.
+//
+int polysim_generate(polysim_run* run, const polysim_results* results,
+					 int count)
+{
+	if(run == NULL || results == NULL || count < 0
+		|| results->lamda1 == NULL || results->lamda2 == NULL
+		|| results->radiusOfGyration == NULL
+		|| results->asphericity == NULL)
+	{
+		return POLYSIM_ERROR_ARGUMENT;
+	}
+
+	bool wantPairs = results->contacts != NULL
+		             || results->selfIntersections != NULL;
+	bool wantHull = results->hullArea != NULL
+		            || results->hullPerimeter != NULL;
+	int beads = run->config.beadAmount;
+
+	for(int i = 0; i < count; i++)
+	{
+		sample* s = &run->workspace;
+
+		s->reset();
+		s->addBeads(beads - 1);
+
+		results->lamda1[i] = s->getLamda1();
+		results->lamda2[i] = s->getLamda2();
+		results->radiusOfGyration[i] = s->getRadiusofGyration();
+		results->asphericity[i] = s->getAsphericity();
+
+		if(wantPairs)
+		{
+			run->pairs.addSample(s);
+
+			if(results->contacts != NULL)
+			{
+				results->contacts[i] = s->getContacts();
+			}
+
+			if(results->selfIntersections != NULL)
+			{
+				results->selfIntersections[i] = s->getSelfIntersections();
+			}
+		}
+
+		if(wantHull)
+		{
+			run->hull.calculate(s);
+
+			if(results->hullArea != NULL)
+			{
+				results->hullArea[i] = s->getHullArea();
+			}
+
+			if(results->hullPerimeter != NULL)
+			{
+				results->hullPerimeter[i] = s->getHullPerimeter();
+			}
+		}
+
+		writeArms(s, results, i);
+
+		if(results->beadsX != NULL && results->beadsY != NULL)
+		{
+			int* x = results->beadsX + (long long)i * beads;
+			int* y = results->beadsY + (long long)i * beads;
+
+			for(int b = 0; b < beads; b++)
+			{
+				x[b] = s->getBeadX(b);
+				y[b] = s->getBeadY(b);
+			}
+		}
+	}
+
+	return POLYSIM_OK;
+}
+
+// Bins a set of values the way the program always has: bins equal
+// bins from zero up to the largest value, each value counted in the
+// first bin whose upper bound is not below it.
+//
+int polysim_histogram(const double* values, int count, int bins,
+					  double* upperBounds, int* frequencies)
+{
+	double max = 0.0, binSize;
+
+	if(values == NULL || count < 0 || bins < 1 || upperBounds == NULL
+		|| frequencies == NULL)
+	{
+		return POLYSIM_ERROR_ARGUMENT;
+	}
+
+	for(int i = 0; i < count; i++)
+	{
+		if(values[i] > max)
+		{
+			max = values[i];
+		}
+	}
+
+	binSize = max / bins;
+
+	for(int i = 1; i <= bins; i++)
+	{
+		frequencies[i - 1] = 0;
+		upperBounds[i - 1] = (double)i * binSize;
+	}
+
+	for(int i = 0; i < count; i++)
+	{
+		for(int j = 0; j < bins; j++)
+		{
+			if(values[i] <= upperBounds[j])
+			{
+				frequencies[j]++;
+				break;
+			}
+		}
+	}
+
+	return POLYSIM_OK;
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      polysim.h                                           *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  The plain C interface to the simulation library. This is the   *//
+//*  only header a program that embeds the simulator needs.         *//
+//*                                                                 *//
+//*  The library never touches the filesystem. Every result is      *//
+//*  written into arrays the caller owns, and all the memory a run  *//
+//*  needs is taken once in polysim_create, never per sample.       *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#ifndef POLYSIM_H
+#define POLYSIM_H
+
+// Define POLYSIM_SHARED when building or using the library as a DLL,
+// and POLYSIM_EXPORTS as well while building it.
+#if defined(_WIN32) && defined(POLYSIM_SHARED)
+#ifdef POLYSIM_EXPORTS
+#define POLYSIM_API __declspec(dllexport)
+#else
+#define POLYSIM_API __declspec(dllimport)
+#endif
+#else
+#define POLYSIM_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Return codes
+#define POLYSIM_OK 0
+#define POLYSIM_ERROR_ARGUMENT -1
+#define POLYSIM_ERROR_MEMORY -2
+
+// Everything that describes a run
+typedef struct polysim_config{
+	int beadAmount;        // beads per sample, counting the origin
+	unsigned int seed;     // seeds the run's own generator, 0 takes
+	                       // one from rand
+} polysim_config;
+
+// Values per sample in polysim_results.armData: s^2 of arms 1 to 5,
+// the asphericity of arms 1 to 5, the end to end R^2 of arms 1 to 5,
+// the branch point separation, then the angles in degrees between
+// arms 1-2, 1-3, 2-3, 4-5, 3-4 and 3-5.
+#define POLYSIM_ARM_VALUES 22
+
+// Where polysim_generate writes. Each array must hold at least count
+// values, armData count * POLYSIM_ARM_VALUES and the bead coordinates
+// count * beadAmount. The first four are required, the rest may be
+// NULL and are only worked out when given.
+typedef struct polysim_results{
+	double* lamda1;
+	double* lamda2;
+	double* radiusOfGyration;
+	double* asphericity;
+	int* contacts;
+	int* selfIntersections;
+	double* hullArea;
+	double* hullPerimeter;
+	double* armRadiusOfGyration;   // mean s^2 of arms 1, 2, 4 and 5
+	double* barRadiusOfGyration;   // s^2 of the crossbar, arm 3
+	double* armEndToEnd;           // mean R^2 of arms 1, 2, 4 and 5
+	double* branchSeparation;
+	double* armAngle;              // mean of the 1-2 and 4-5 angles
+	double* armData;
+	int* beadsX;
+	int* beadsY;
+} polysim_results;
+
+// A run, only ever handled through a pointer
+typedef struct polysim_run polysim_run;
+
+// Functionality
+POLYSIM_API const char* polysim_version(void);
+POLYSIM_API void polysim_default_config(polysim_config* config);
+POLYSIM_API polysim_run* polysim_create(const polysim_config* config);
+POLYSIM_API void polysim_destroy(polysim_run* run);
+POLYSIM_API int polysim_generate(polysim_run* run,
+								 const polysim_results* results,
+								 int count);
+POLYSIM_API int polysim_histogram(const double* values, int count,
+								  int bins, double* upperBounds,
+								  int* frequencies);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      progress.cpp                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the progressMonitor class. *//
+//*  The builders only ever take a lock for a few additions, all    *//
+//*  the formatting and file work is done on the reporter thread.   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "progress.h"
+using namespace std;
+
+// Names the four quantities take in a snapshot
+const char* const QUANTITY_NAMES[4] = {"lamda1", "lamda2",
+									   "radiusOfGyration", "asphericity"};
+
+// Defines how long the reporter sleeps between checks for the end
+const int PROGRESS_SLICE = 50;
+
+// Constructor for a progress monitor. socketName may be NULL.
+//
+progressMonitor::progressMonitor(int sampleTotal, double tolerance,
+								 const char* fileName,
+								 const char* socketName)
+{
+	this->sampleTotal = sampleTotal;
+	this->tolerance = tolerance;
+	this->fileName = fileName;
+	this->socketName = socketName;
+	socketHandle = -1;
+	startTime = 0.0;
+	samplesDone = 0;
+	stopping = 0;
+	converged = 0;
+	reporter = NULL;
+
+	for(int q = 0; q < 4; q++)
+	{
+		sums[q] = 0.0;
+		squares[q] = 0.0;
+	}
+}
+
+// Destructor for a progress monitor.
+//
+progressMonitor::~progressMonitor(void)
+{
+	if(reporter != NULL)
+	{
+		finish();
+	}
+}
+
+// Starts the clock and the reporter thread.
+//
+void progressMonitor::start()
+{
+	startTime = getWallSeconds();
+	openSocket();
+	writeSnapshot(false);
+	reporter = startThread(reporterEntry, this);
+}
+
+// Adds one finished sample to the running sums. Safe to call from any
+// number of threads at once.
+//
+void progressMonitor::addSample(sample* s)
+{
+	addValues(s->getLamda1(), s->getLamda2(), s->getRadiusofGyration(),
+			  s->getAsphericity());
+}
+
+// Adds the shape of one finished sample to the running sums. Safe to
+// call from any number of threads at once.
+//
+void progressMonitor::addValues(double lamda1, double lamda2,
+								double radiusofGyration, 
+								double asphericity)
+{
+	double values[4] = {lamda1, lamda2, radiusofGyration, asphericity};
+
+	sumsLock.lock();
+
+	for(int q = 0; q < 4; q++)
+	{
+		sums[q] += values[q];
+		squares[q] += values[q] * values[q];
+	}
+
+	// Counted inside the lock so a snapshot never sees a count that
+	// does not match its sums
+	atomicAdd(&samplesDone, 1);
+
+	sumsLock.unlock();
+}
+
+// Stops the reporter and writes the final snapshot.
+//
+void progressMonitor::finish()
+{
+	if(reporter == NULL)
+	{
+		return;
+	}
+
+	atomicAdd(&stopping, 1);
+	joinThread(reporter);
+	reporter = NULL;
+
+	writeSnapshot(true);
+	closeSocket();
+}
+
+// Where the reporter thread starts.
+//
+void progressMonitor::reporterEntry(void* args)
+{
+	((progressMonitor*)args)->report();
+}
+
+// Writes a snapshot every PROGRESS_INTERVAL until finish is called.
+// The wait is cut into slices so finish never has to wait long.
+//
+void progressMonitor::report()
+{
+	int waited = 0;
+
+	while(stopping == 0)
+	{
+		sleepMilliseconds(PROGRESS_SLICE);
+		waited += PROGRESS_SLICE;
+
+		if(waited >= PROGRESS_INTERVAL && stopping == 0)
+		{
+			writeSnapshot(false);
+			waited = 0;
+		}
+	}
+}
+
+// Copies the running sums, judges convergence and writes the snapshot
+// to the file and the socket.
+//
+void progressMonitor::writeSnapshot(bool finished)
+{
+	double copySums[4], copySquares[4], mean[4], sd[4];
+	int done;
+
+	sumsLock.lock();
+
+	done = (int)samplesDone;
+
+	for(int q = 0; q < 4; q++)
+	{
+		copySums[q] = sums[q];
+		copySquares[q] = squares[q];
+	}
+
+	sumsLock.unlock();
+
+	// Averages and standard deviations of the mean so far
+	bool allConverged = done >= MIN_CONVERGED_SAMPLES && tolerance > 0.0;
+
+	for(int q = 0; q < 4; q++)
+	{
+		mean[q] = 0.0;
+		sd[q] = 0.0;
+
+		if(done > 0)
+		{
+			mean[q] = copySums[q] / done;
+		}
+
+		if(done > 1)
+		{
+			double variance = copySquares[q] / done - mean[q] * mean[q];
+			sd[q] = (variance > 0.0) ? sqrt(variance / (done - 1)) : 0.0;
+		}
+
+		if(sd[q] > tolerance * fabs(mean[q]))
+		{
+			allConverged = false;
+		}
+	}
+
+	if(allConverged && converged == 0)
+	{
+		atomicAdd(&converged, 1);
+	}
+
+	// Throughput and time left
+	double elapsed = getWallSeconds() - startTime;
+	double rate = (elapsed > 0.0) ? done / elapsed : 0.0;
+	double eta = (rate > 0.0) ? (sampleTotal - done) / rate : -1.0;
+
+	if(finished)
+	{
+		eta = 0.0;
+	}
+
+	ostringstream json;
+	json.setf(ios::fixed);
+	json.precision(6);
+
+	json << "{\n";
+	json << "  \"samplesDone\": " << done << ",\n";
+	json << "  \"samplesTotal\": " << sampleTotal << ",\n";
+	json << "  \"elapsedSeconds\": " << elapsed << ",\n";
+	json << "  \"samplesPerSecond\": " << rate << ",\n";
+	json << "  \"etaSeconds\": " << eta << ",\n";
+
+	for(int q = 0; q < 4; q++)
+	{
+		json << "  \"" << QUANTITY_NAMES[q] << "\": {\"mean\": "
+			 << mean[q] << ", \"sd\": " << sd[q] << "},\n";
+	}
+
+	json << "  \"converged\": " << (converged ? "true" : "false") << ",\n";
+	json << "  \"finished\": " << (finished ? "true" : "false") << "\n";
+	json << "}\n";
+
+	string text = json.str();
+
+	// Write beside the old snapshot then swap it in
+	string temporary = string(fileName) + ".tmp";
+	ofstream snapshotFile(temporary.c_str());
+
+	if(!snapshotFile.fail())
+	{
+		snapshotFile << text;
+		snapshotFile.close();
+
+#ifdef _WIN32
+		MoveFileExA(temporary.c_str(), fileName,
+					MOVEFILE_REPLACE_EXISTING);
+#else
+		rename(temporary.c_str(), fileName);
+#endif
+	}
+
+	serveSocket(text.c_str(), (int)text.length());
+}
+
+// Starts listening on the socket if one was asked for. Any failure
+// just leaves the socket off, the file is still written. Only a stale
+// socket left behind by an earlier run is removed first, anything
+// else already at the path is left alone and the socket stays off.
+//
+void progressMonitor::openSocket()
+{
+#ifndef _WIN32
+	sockaddr_un address;
+	struct stat existing;
+
+	if(socketName == NULL || strlen(socketName) >= sizeof(address.sun_path))
+	{
+		return;
+	}
+
+	if(lstat(socketName, &existing) == 0)
+	{
+		if(!S_ISSOCK(existing.st_mode))
+		{
+			return;
+		}
+
+		unlink(socketName);
+	}
+
+	socketHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if(socketHandle < 0)
+	{
+		socketHandle = -1;
+		return;
+	}
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketName);
+
+	if(bind(socketHandle, (sockaddr*)&address, sizeof(address)) != 0
+		|| listen(socketHandle, 8) != 0)
+	{
+		close(socketHandle);
+		socketHandle = -1;
+		return;
+	}
+
+	fcntl(socketHandle, F_SETFL,
+		  fcntl(socketHandle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+// Sends a snapshot to every client waiting on the socket.
+//
+void progressMonitor::serveSocket(const char* text, int length)
+{
+#ifndef _WIN32
+	if(socketHandle < 0)
+	{
+		return;
+	}
+
+	while(true)
+	{
+		int client = accept(socketHandle, NULL, NULL);
+
+		if(client < 0)
+		{
+			break;
+		}
+
+#ifdef MSG_NOSIGNAL
+		send(client, text, length, MSG_NOSIGNAL);
+#else
+		send(client, text, length, 0);
+#endif
+		close(client);
+	}
+#endif
+}
+
+// Stops listening and removes the socket.
+//
+void progressMonitor::closeSocket()
+{
+#ifndef _WIN32
+	if(socketHandle < 0)
+	{
+		return;
+	}
+
+	close(socketHandle);
+	unlink(socketName);
+	socketHandle = -1;
+#endif
+}
+
+// Below this point are all get functions
+//
+bool progressMonitor::isConverged()
+{
+	return converged != 0;
+}
+
+int progressMonitor::getSamplesDone()
+{
+	return (int)atomicAdd(&samplesDone, 0);
+}
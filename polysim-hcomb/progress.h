@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      progress.h                                          *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the progressMonitor class.                     *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+#include "threads.h"
+
+// Defines how often a snapshot is written, in milliseconds
+const int PROGRESS_INTERVAL = 1000;
+
+// Defines the fewest samples convergence is ever judged on
+const int MIN_CONVERGED_SAMPLES = 100;
+
+// Watches a run while it builds samples. Whoever builds a sample hands
+// it to addSample, or just its shape to addValues, which only adds the
+// four shape quantities to running sums. A reporter thread of the
+// monitor's own wakes every PROGRESS_INTERVAL and writes a JSON
+// snapshot of how far along the run is and what the averages look like
+// so far.
+//
+// The snapshot file is written beside itself and renamed over the old
+// one, so a reader never sees half a snapshot. On systems with Unix
+// domain sockets the same snapshot can also be served on a socket:
+// every client that connects is sent the next snapshot and closed.
+//
+// With a tolerance above zero the reporter also marks the run converged
+// once the standard deviation of the mean of every quantity is within
+// tolerance of its average. Builders check isConverged and stop early.
+class progressMonitor
+{
+private:
+	int sampleTotal;
+	double tolerance;
+	const char* fileName;
+	const char* socketName;
+	int socketHandle;
+	double startTime;
+
+	// Running sums, guarded by sumsLock. The count is also changed
+	// atomically so it can be read without the lock.
+	threadLock sumsLock;
+	volatile long samplesDone;
+	double sums[4];
+	double squares[4];
+
+	// Set once, read without the lock
+	volatile long stopping;
+	volatile long converged;
+
+	threadHandle* reporter;
+
+	static void reporterEntry(void* args);
+	void report();
+	void writeSnapshot(bool finished);
+	void openSocket();
+	void serveSocket(const char* text, int length);
+	void closeSocket();
+
+public:
+	// Constructor and destructor
+	progressMonitor(int sampleTotal, double tolerance,
+					const char* fileName, const char* socketName);
+	~progressMonitor(void);
+
+	// Functionality
+	void start();
+	void addSample(sample* s);
+	void addValues(double lamda1, double lamda2, double radiusofGyration,
+				   double asphericity);
+	void finish();
+
+	// Gets and sets
+	bool isConverged();
+	int getSamplesDone();
+};
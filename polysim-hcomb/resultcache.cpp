@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      resultcache.cpp                                     *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the resultCache class.     *//
+//*  Values are written with 17 digits so they read back exactly.   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include "resultcache.h"
+using namespace std;
+
+// Defines the first line of every cache file
+const char* const CACHE_HEADER = "PolySim H-Comb result cache";
+
+// Defines the line written after the last sample. A file cut off in
+// its last number still reads as a whole row, so only this line says
+// the rows are all there.
+const char* const CACHE_FOOTER = "end";
+
+// Returns the 64 bit FNV-1a hash of a string.
+//
+static unsigned long long hashKey(const string& text)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for(size_t i = 0; i < text.length(); i++)
+	{
+		hash ^= (unsigned char)text[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+// Constructor for a cache. The directory is made if it is missing.
+//
+resultCache::resultCache(const char* directory, const string& key)
+{
+	char name[32];
+
+	this->key = key;
+	sprintf(name, "%016llx.txt", hashKey(key));
+	fileName = string(directory) + "/" + name;
+	sampleCount = 0;
+	capacity = 0;
+	damaged = false;
+
+	for(int q = 0; q < 4; q++)
+	{
+		values[q] = NULL;
+	}
+
+#ifdef _WIN32
+	_mkdir(directory);
+#else
+	mkdir(directory, 0777);
+#endif
+}
+
+// Destructor for a cache.
+//
+resultCache::~resultCache(void)
+{
+	for(int q = 0; q < 4; q++)
+	{
+		delete [] values[q];
+	}
+}
+
+// Makes room for at least needed samples.
+//
+void resultCache::grow(int needed)
+{
+	if(needed <= capacity)
+	{
+		return;
+	}
+
+	int newCapacity = (capacity > 0) ? capacity * 2 : 1024;
+
+	if(newCapacity < needed)
+	{
+		newCapacity = needed;
+	}
+
+	for(int q = 0; q < 4; q++)
+	{
+		double* moved = new double[newCapacity];
+
+		for(int i = 0; i < sampleCount; i++)
+		{
+			moved[i] = values[q][i];
+		}
+
+		delete [] values[q];
+		values[q] = moved;
+	}
+
+	capacity = newCapacity;
+}
+
+// Reads the samples kept for the key. Returns false, with no samples,
+// if there is no file or it was made for another key. A file for the
+// key that ends before all its samples and the footer is marked
+// damaged. The last sample that read may have been cut off part way
+// through a number, so it is dropped and the rest are kept.
+//
+bool resultCache::load()
+{
+	ifstream cacheFile(fileName.c_str());
+	string line;
+	int count = 0;
+
+	sampleCount = 0;
+	damaged = false;
+
+	if(cacheFile.fail())
+	{
+		return false;
+	}
+
+	if(!getline(cacheFile, line) || line != CACHE_HEADER
+		|| !getline(cacheFile, line) || line != key)
+	{
+		return false;
+	}
+
+	if(!(cacheFile >> count) || count < 0)
+	{
+		damaged = true;
+		return false;
+	}
+
+	grow(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		double v[4];
+
+		if(!(cacheFile >> v[0] >> v[1] >> v[2] >> v[3]))
+		{
+			damaged = true;
+			break;
+		}
+
+		addSample(v[0], v[1], v[2], v[3]);
+	}
+
+	if(!damaged && (!(cacheFile >> line) || line != CACHE_FOOTER))
+	{
+		damaged = true;
+	}
+
+	if(damaged && sampleCount > 0)
+	{
+		sampleCount--;
+	}
+
+	return sampleCount > 0;
+}
+
+// Writes every sample kept out to the file for the key.
+//
+bool resultCache::save()
+{
+	string temporary = fileName + ".tmp";
+	ofstream cacheFile(temporary.c_str());
+
+	if(cacheFile.fail())
+	{
+		return false;
+	}
+
+	cacheFile.precision(17);
+	cacheFile << CACHE_HEADER << "\n" << key << "\n" << sampleCount 
+			  << "\n";
+
+	for(int i = 0; i < sampleCount; i++)
+	{
+		cacheFile << values[0][i] << "\t" << values[1][i] << "\t" 
+				  << values[2][i] << "\t" << values[3][i] << "\n";
+	}
+
+	cacheFile << CACHE_FOOTER << "\n";
+
+	cacheFile.close();
+
+	if(cacheFile.fail())
+	{
+		remove(temporary.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	return MoveFileExA(temporary.c_str(), fileName.c_str(),
+					   MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(temporary.c_str(), fileName.c_str()) == 0;
+#endif
+}
+
+// Adds the quantities of the next sample.
+//
+void resultCache::addSample(double lamda1, double lamda2, 
+							double radiusofGyration, double asphericity)
+{
+	grow(sampleCount + 1);
+
+	values[0][sampleCount] = lamda1;
+	values[1][sampleCount] = lamda2;
+	values[2][sampleCount] = radiusofGyration;
+	values[3][sampleCount] = asphericity;
+	sampleCount++;
+}
+
+// Below this point are all get functions
+//
+bool resultCache::isDamaged()
+{
+	return damaged;
+}
+
+int resultCache::getSampleCount()
+{
+	return sampleCount;
+}
+
+// Lamda1, lamda2, s^2 and A are quantities 0 to 3.
+//
+double* resultCache::getValues(int quantity)
+{
+	return values[quantity];
+}
+
+const string& resultCache::getFileName()
+{
+	return fileName;
+}
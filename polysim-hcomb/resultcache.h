@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      resultcache.h                                       *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the resultCache class.                         *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+
+// Keeps the shape quantities of every sample a run has grown on disk,
+// so the same run asked for again is read back instead of grown. The
+// file is named by a hash of a key that must hold everything the
+// results depend on: the configuration, the seed and the engine
+// version. The key itself is the first line of the file and is checked
+// on load, so two keys with the same hash can never mix.
+//
+// Sample i of a run must come out the same whether it is grown alone
+// or after samples 0 to i - 1, so a run that asks for more samples than
+// are kept only grows the ones past the end and adds them on. The
+// file is written beside itself and renamed over the old one, so a run
+// stopped part way through leaves the last whole file behind. A file
+// that is damaged anyway, or has no footer after its rows, is read as
+// far as it goes, less its last row, and reported.
+//
+// Only streamed runs are kept. Static growth also outputs p(r), S(q)
+// and contacts from the coordinates of every sample, which the shape
+// quantities kept here cannot give back.
+class resultCache
+{
+private:
+	std::string key;
+	std::string fileName;
+	int sampleCount, capacity;
+	bool damaged;
+	double* values[4];
+
+	void grow(int needed);
+
+public:
+	// Constructor and destructor
+	resultCache(const char* directory, const std::string& key);
+	~resultCache(void);
+
+	// Functionality
+	bool load();
+	bool save();
+	void addSample(double lamda1, double lamda2, double radiusofGyration,
+				   double asphericity);
+
+	// Gets and sets
+	bool isDamaged();
+	int getSampleCount();
+	double* getValues(int quantity);
+	const std::string& getFileName();
+};
@@ -14,11 +14,22 @@
 using namespace std;
 #include "sample.h"
 
+// Turns radians into degrees
+const double DEGREES = 180.0 / 3.14159265358979323846;
 
 // Constructor for a sample. When a sample is made it is
 // automatically given an initial bead at coordinates 0,0
 //
 sample::sample(void)
+{
+	randomState = 0;
+	reset();
+}
+
+// Puts a sample back the way the constructor left it, so one sample
+// can be reused for many conformations without being reallocated.
+//
+void sample::reset()
 {
 	beadCount = 0;
 	beadsX[beadCount] = 0;
@@ -32,6 +43,22 @@ sample::sample(void)
 	currentArm = 1;
 	beadCount++;	
 	buildExtraArms = false;
+	starBeadCount = 0;
+	arm3HeadIndex = 0;
+	contacts = 0;
+	selfIntersections = 0;
+	hullArea = 0.0;
+	hullPerimeter = 0.0;
+
+	for(int a = 0; a < 5; a++)
+	{
+		armShapes[a].lamda1 = 0.0;
+		armShapes[a].lamda2 = 0.0;
+		armShapes[a].radiusofGyration = 0.0;
+		armShapes[a].asphericity = 0.0;
+		armEndX[a] = 0;
+		armEndY[a] = 0;
+	}
 }
 
 // Destructor for a sample.
@@ -91,7 +118,8 @@ void sample::addBead()
 //
 void sample::growArm(int x, int y, int currentArm)
 {
-	int growDirection = rand() % 4 + 1;
+	int growDirection = (randomState != 0) ? randomDirection() 
+		                                   : rand() % 4 + 1;
 
 	switch(growDirection)
 	{
@@ -122,6 +150,13 @@ void sample::growArm(int x, int y, int currentArm)
 	setHead(x, y, currentArm);
 	beadsX[beadCount] = x;
 	beadsY[beadCount] = y;
+
+	// Remember where arm 3 ends, arms 4 and 5 are grafted there
+	if(currentArm == 3)
+	{
+		arm3HeadIndex = beadCount;
+	}
+
 	//cout << "Arm " << currentArm << ": (" << x << ", " << y << ")" << endl;
 	beadCount++;
 }
@@ -199,6 +234,9 @@ void sample::setExtraArmParams()
 	// Switch the current arm to 4.
 	currentArm = 4;
 
+	// Everything before this point belongs to the star
+	starBeadCount = beadCount;
+
 	// Set the heads of the two arms to the endpoint of one
 	// of the ends of the star we have constructed. I chose 
 	// 3 but any can be used.
@@ -247,89 +285,43 @@ int sample::getBeadCount()
 	return beadCount;
 }
 
-// Returns average X coordinate across all beads
-// Shows us the X coordinate for the center of mass
-// of our sample.
+// Returns the index of the bead the given bead is bonded to on the
+// way back towards the origin, or -1 for the origin bead itself.
+// Beads are stored in growth order, so the star arms interleave with
+// a stride of 3 and arms 4 and 5 with a stride of 2.
 //
-double sample::calculateXCM()
+int sample::getBondedBead(int index)
 {
-	double sum = 0.0;
-
-	for(int i = 0; i < beadCount; i++)
+	if(index <= 0)
 	{
-		sum += beadsX[i];
+		return -1;
 	}
 
-	sum = sum / beadCount;
-
-	return sum;
-}
-
-// Returns average Y coordinate accross all beads
-// Shows us the Y coordinate for the center of mass
-// of our sample.
-//
-double sample::calculateYCM()
-{
-	double sum = 0.0;
-
-	for(int i = 0; i < beadCount; i++)
+	if(starBeadCount == 0 || index < starBeadCount)
 	{
-		sum += beadsY[i];
+		return (index <= 3) ? 0 : index - 3;
 	}
 
-	sum = sum / beadCount;
-
-	return sum;
-}
-
-// Returns the tensor for matrix position 1,1
-//
-double sample::calculateTensor11()
-{
-	double sum = 0.0;
-
-	for(int i = 0; i < beadCount; i++)
+	if(index - starBeadCount < 2)
 	{
-		sum += pow((beadsX[i] - XCM), 2.0);
+		return arm3HeadIndex;
 	}
 
-	sum = sum / beadCount;
-
-	return sum;
+	return index - 2;
 }
 
-// Returns the tensor for matrix position 1,2
-// Same as Tensor21
+// Returns the X coordinate of the bead at a given index
 //
-double sample::calculateTensor12()
+int sample::getBeadX(int index)
 {
-	double sum = 0.0;
-
-	for(int i = 0; i < beadCount; i++)
-	{
-		sum += ((beadsX[i] - XCM) * (beadsY[i] - YCM));
-	}
-
-	sum = sum / beadCount;
-
-	return sum;
+	return beadsX[index];
 }
 
-// Returns the tensor for matrix position 2,2
+// Returns the Y coordinate of the bead at a given index
 //
-double sample::calculateTensor22()
+int sample::getBeadY(int index)
 {
-	double sum = 0.0;
-
-	for(int i = 0; i < beadCount; i++)
-	{
-		sum += pow((beadsY[i] - YCM), 2.0);
-	}
-
-	sum = sum / beadCount;
-
-	return sum;
+	return beadsY[index];
 }
 
 // Returns Lamda1 which is the distance from the center of mass to the
@@ -384,15 +376,143 @@ double sample::calculateRadiusofGyration()
 }
 
 // Runs all the necessary calculations on the sample and stores them.
+// The beads are gone through once. Their growth order puts the star
+// arms at a stride of 3 from bead 1 and arms 4 and 5 at a stride of 2
+// from starBeadCount, so each bead's arm comes from its index alone
+// and is added to that arm's moments. The whole molecule is then the
+// origin plus the five arms.
 //
 void sample::runCalculations()
 {
-	XCM = calculateXCM();
-	YCM = calculateYCM();
-	tensor11 = calculateTensor11();
-	tensor12 = calculateTensor12();
-	tensor22 = calculateTensor22();
+	moments arms[5], total;
+	int armLast[5] = {0, 0, 0, 0, 0};
+	int starEnd = (starBeadCount > 0) ? starBeadCount : beadCount;
+	int arm = 0;
+
+	for(int a = 0; a < 5; a++)
+	{
+		clearMoments(arms[a]);
+	}
+
+	// The star, arms 1, 2 and 3 in turn
+	for(int i = 1; i < starEnd; i++)
+	{
+		addPoint(arms[arm], beadsX[i], beadsY[i]);
+		armLast[arm] = i;
+		arm = (arm == 2) ? 0 : arm + 1;
+	}
+
+	// Arms 4 and 5 in turn, both grown from the head of arm 3
+	armLast[3] = armLast[2];
+	armLast[4] = armLast[2];
+
+	for(int i = starEnd; i < beadCount; i++)
+	{
+		arm = 3 + (i - starEnd) % 2;
+		addPoint(arms[arm], beadsX[i], beadsY[i]);
+		armLast[arm] = i;
+	}
+
+	clearMoments(total);
+	addPoint(total, beadsX[0], beadsY[0]);
+
+	for(int a = 0; a < 5; a++)
+	{
+		addMoments(total, arms[a], 0, 0);
+	}
+
+	double n = (double)total.n;
+
+	XCM = total.sx / n;
+	YCM = total.sy / n;
+	tensor11 = total.sxx / n - XCM * XCM;
+	tensor12 = total.sxy / n - XCM * YCM;
+	tensor22 = total.syy / n - YCM * YCM;
 
+	runShapeCalculations();
+
+	// Each arm from the branch point it grows from
+	for(int a = 0; a < 5; a++)
+	{
+		int root = (a < 3) ? 0 : armLast[2];
+
+		addPoint(arms[a], beadsX[root], beadsY[root]);
+
+		if(arms[a].n > 1)
+		{
+			calculateShape(arms[a], armShapes[a]);
+		}
+
+		armEndX[a] = beadsX[armLast[a]] - beadsX[root];
+		armEndY[a] = beadsY[armLast[a]] - beadsY[root];
+	}
+}
+
+// Gives the sample a random number generator of its own, so samples
+// can be grown without touching rand. A seed of 0 goes back to rand.
+//
+void sample::setSeed(unsigned long long seed)
+{
+	randomState = seed;
+}
+
+// Returns a direction from 1 to 4, as rand() % 4 + 1 does, from the
+// sample's own generator (xorshift64*)
+//
+int sample::randomDirection()
+{
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+
+	return (int)((randomState * 2685821657736338717ULL) >> 62) + 1;
+}
+
+// Loads the coordinates of a conformation that addBeads grew with the
+// same bead count, so it can be looked at again without regrowing it.
+// Only the beads and which bead each is bonded to are restored, the
+// shape is not worked out.
+//
+void sample::setBeads(const int* beadsX, const int* beadsY, int beadCount)
+{
+	int amount = beadCount - 1;
+	int star = amount - (amount / 5) * 2;
+
+	reset();
+
+	for(int i = 0; i < beadCount; i++)
+	{
+		this->beadsX[i] = beadsX[i];
+		this->beadsY[i] = beadsY[i];
+	}
+
+	// The star takes arms 1, 2 and 3 in turn, so arm 3 ends on the
+	// last multiple of 3 in it
+	this->beadCount = beadCount;
+	starBeadCount = star + 1;
+	arm3HeadIndex = (star / 3) * 3;
+}
+
+// Stores a gyration tensor worked out somewhere else, such as from
+// off lattice coordinates, and runs the shape calculations on it.
+//
+void sample::setTensor(double xcm, double ycm, double tensor11, 
+					   double tensor12, double tensor22)
+{
+	XCM = xcm;
+	YCM = ycm;
+	this->tensor11 = tensor11;
+	this->tensor12 = tensor12;
+	this->tensor22 = tensor22;
+
+	runShapeCalculations();
+}
+
+// Works out the lamdas, asphericity and radius of gyration from the
+// stored gyration tensor.
+//
+void sample::runShapeCalculations()
+{
 	// Stores the lamdas in temp variables
 	double temp1 = calculateLamda1();
 	double temp2 = calculateLamda2();
@@ -456,4 +576,108 @@ double sample::getAsphericity()
 double sample::getRadiusofGyration()
 {
 	return radiusofGyration;
-}
\ No newline at end of file
+}
+
+int sample::getContacts()
+{
+	return contacts;
+}
+
+int sample::getSelfIntersections()
+{
+	return selfIntersections;
+}
+
+void sample::setContacts(int contacts)
+{
+	this->contacts = contacts;
+}
+
+void sample::setSelfIntersections(int selfIntersections)
+{
+	this->selfIntersections = selfIntersections;
+}
+
+double sample::getHullArea()
+{
+	return hullArea;
+}
+
+double sample::getHullPerimeter()
+{
+	return hullPerimeter;
+}
+
+void sample::setHullArea(double hullArea)
+{
+	this->hullArea = hullArea;
+}
+
+void sample::setHullPerimeter(double hullPerimeter)
+{
+	this->hullPerimeter = hullPerimeter;
+}
+
+// Arms are numbered 1 to 5, as they are grown.
+//
+double sample::getArmRadiusofGyration(int arm)
+{
+	return armShapes[arm - 1].radiusofGyration;
+}
+
+double sample::getArmAsphericity(int arm)
+{
+	return armShapes[arm - 1].asphericity;
+}
+
+int sample::getArmEndX(int arm)
+{
+	return armEndX[arm - 1];
+}
+
+int sample::getArmEndY(int arm)
+{
+	return armEndY[arm - 1];
+}
+
+// Returns the squared end to end distance of an arm
+//
+double sample::getArmEndToEnd(int arm)
+{
+	double x = armEndX[arm - 1], y = armEndY[arm - 1];
+
+	return x * x + y * y;
+}
+
+// Returns the distance between the two branch points, the origin and
+// the head of arm 3, which is how far the crossbar reaches.
+//
+double sample::getBranchSeparation()
+{
+	return sqrt(getArmEndToEnd(3));
+}
+
+// Returns the angle in degrees between the ends of two arms, each seen
+// from the branch point it grows from. Arm 3 is seen from the other
+// end when paired with arm 4 or 5, so the angles at either branch
+// point are between arms that meet there. An arm that ends where it
+// started has no direction and gives 0.
+//
+double sample::getArmAngle(int arm, int otherArm)
+{
+	double x1 = armEndX[arm - 1], y1 = armEndY[arm - 1];
+	double x2 = armEndX[otherArm - 1], y2 = armEndY[otherArm - 1];
+
+	if(arm == 3 && otherArm > 3)
+	{
+		x1 = -x1;
+		y1 = -y1;
+	}
+	else if(otherArm == 3 && arm > 3)
+	{
+		x2 = -x2;
+		y2 = -y2;
+	}
+
+	return atan2(fabs(x1 * y2 - y1 * x2), x1 * x2 + y1 * y2) * DEGREES;
+}
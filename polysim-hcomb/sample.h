@@ -7,6 +7,7 @@
 //*                                                                 *//
 ///////////////////////////////////////////////////////////////////////
 #pragma once
+#include "moments.h"
 
 // Defines the maximum number of beads the simulation can use.
 const int MAX_BEADS = 10000;
@@ -22,21 +23,27 @@ class sample
 private:
 	int beadsX[MAX_BEADS];
 	int beadsY[MAX_BEADS];
-	int beadCount, currentArm;
+	int beadCount, currentArm, starBeadCount, arm3HeadIndex;
 	coordinate arm1Head, arm2Head, arm3Head, arm4Head, arm5Head;
 	bool buildExtraArms;
+	unsigned long long randomState;
 
 	double XCM, YCM, tensor11, tensor12, tensor22, lamda1, lamda2, 
 		asphericity, radiusofGyration;
+	int contacts, selfIntersections;
+	double hullArea, hullPerimeter;
+
+	// Arms 1 to 5 at index 0 to 4. Each arm's shape counts the branch
+	// point it grows from, and its end is measured from there.
+	shape armShapes[5];
+	int armEndX[5];
+	int armEndY[5];
 
 	void runCalculations();
+	void runShapeCalculations();
+	int randomDirection();
 
 	// Calculation functions
-	double calculateXCM();
-	double calculateYCM();
-	double calculateTensor11();
-	double calculateTensor12();
-	double calculateTensor22();
 	double calculateLamda1();
 	double calculateLamda2();
 	double calculateAsphericity();
@@ -48,15 +55,23 @@ public:
 	~sample(void);
 
 	// Functionality
+	void reset();
 	void addBead();
 	void addBeads(int amount);
 	void advanceCurrentArm();
 	void growArm(int x, int y, int currentArm);
 	void setHead(int x, int y, int currentArm);
 	void setExtraArmParams();
+	void setTensor(double xcm, double ycm, double tensor11, 
+		           double tensor12, double tensor22);
+	void setSeed(unsigned long long seed);
+	void setBeads(const int* beadsX, const int* beadsY, int beadCount);
 
 	// Gets and sets
 	int getBeadCount();
+	int getBeadX(int index);
+	int getBeadY(int index);
+	int getBondedBead(int index);
 	double getXCM();
 	double getYCM();
 	double getTensor11();
@@ -66,4 +81,19 @@ public:
 	double getLamda2();
 	double getAsphericity();
 	double getRadiusofGyration();
+	int getContacts();
+	int getSelfIntersections();
+	void setContacts(int contacts);
+	void setSelfIntersections(int selfIntersections);
+	double getHullArea();
+	double getHullPerimeter();
+	void setHullArea(double hullArea);
+	void setHullPerimeter(double hullPerimeter);
+	double getArmRadiusofGyration(int arm);
+	double getArmAsphericity(int arm);
+	int getArmEndX(int arm);
+	int getArmEndY(int arm);
+	double getArmEndToEnd(int arm);
+	double getBranchSeparation();
+	double getArmAngle(int arm, int otherArm);
 };
@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      scaling.cpp                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the scalingTrajectory      *//
+//*  class. One growth per sample replaces a whole sweep of runs    *//
+//*  over the bead amount when fitting the Flory exponent.          *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <math.h>
+#include "sample.h"
+#include "scaling.h"
+
+// Indices of the quantities kept for every checkpoint
+const int Q_LAMDA1 = 0;
+const int Q_LAMDA2 = 1;
+const int Q_RADIUSOFGYRATION = 2;
+const int Q_ASPHERICITY = 3;
+
+// Constructor for a scaling trajectory. Checkpoints run from the
+// smallest to the largest bead amount, each one ratio times the
+// last, rounded to the nearest whole arm length.
+//
+scalingTrajectory::scalingTrajectory(int smallestBeads, int largestBeads,
+									 double ratio)
+{
+	double target = smallestBeads;
+	int largestArm = (int)((largestBeads - 1) / 5.0 + 0.5);
+
+	checkpointCount = 0;
+	sampleCount = 0;
+	exponent = 0.0;
+	exponentError = 0.0;
+
+	if(ratio <= 1.0)
+	{
+		ratio = 2.0;
+	}
+
+	while(target <= largestBeads && checkpointCount < MAX_CHECKPOINTS)
+	{
+		int length = (int)((target - 1) / 5.0 + 0.5);
+
+		if(length >= 1 && (checkpointCount == 0
+			|| length > armLength[checkpointCount - 1]))
+		{
+			armLength[checkpointCount] = length;
+			checkpointCount++;
+		}
+
+		target = target * ratio;
+	}
+
+	// Always finish on the largest bead amount asked for
+	if(checkpointCount < MAX_CHECKPOINTS && largestArm >= 1
+		&& (checkpointCount == 0
+		|| largestArm > armLength[checkpointCount - 1]))
+	{
+		armLength[checkpointCount] = largestArm;
+		checkpointCount++;
+	}
+
+	for(int q = 0; q < 4; q++)
+	{
+		for(int i = 0; i < MAX_CHECKPOINTS; i++)
+		{
+			sum[q][i] = 0.0;
+			sumSq[q][i] = 0.0;
+		}
+	}
+
+	for(int b = 0; b < JACKKNIFE_BLOCKS; b++)
+	{
+		blockCount[b] = 0;
+
+		for(int i = 0; i < MAX_CHECKPOINTS; i++)
+		{
+			blockSum[b][i] = 0.0;
+		}
+	}
+}
+
+// Destructor for a scaling trajectory.
+//
+scalingTrajectory::~scalingTrajectory(void)
+{
+
+}
+
+// Grows one H-Comb through every checkpoint and adds its shape at
+// each of them to the sums.
+//
+void scalingTrajectory::addSample()
+{
+	coordinate heads[5];
+	moments arms[5];
+	int length = 0;
+	int block = sampleCount % JACKKNIFE_BLOCKS;
+
+	for(int a = 0; a < 5; a++)
+	{
+		heads[a].x = 0;
+		heads[a].y = 0;
+		clearMoments(arms[a]);
+	}
+
+	for(int c = 0; c < checkpointCount; c++)
+	{
+		// Grow every arm one bead at a time up to this checkpoint
+		for(; length < armLength[c]; length++)
+		{
+			for(int a = 0; a < 5; a++)
+			{
+				switch(rand() % 4 + 1)
+				{
+				case 1:
+					heads[a].y++;
+					break;
+
+				case 2:
+					heads[a].y--;
+					break;
+
+				case 3:
+					heads[a].x++;
+					break;
+
+				case 4:
+					heads[a].x--;
+					break;
+
+				default:;
+				}
+
+				addPoint(arms[a], heads[a].x, heads[a].y);
+			}
+		}
+
+		// Put the molecule together. Arms 4 and 5 hang off the head
+		// of arm 3.
+		moments whole;
+		shape result;
+
+		clearMoments(whole);
+		addPoint(whole, 0, 0);
+		addMoments(whole, arms[0], 0, 0);
+		addMoments(whole, arms[1], 0, 0);
+		addMoments(whole, arms[2], 0, 0);
+		addMoments(whole, arms[3], heads[2].x, heads[2].y);
+		addMoments(whole, arms[4], heads[2].x, heads[2].y);
+
+		calculateShape(whole, result);
+
+		sum[Q_LAMDA1][c] += result.lamda1;
+		sumSq[Q_LAMDA1][c] += result.lamda1 * result.lamda1;
+		sum[Q_LAMDA2][c] += result.lamda2;
+		sumSq[Q_LAMDA2][c] += result.lamda2 * result.lamda2;
+		sum[Q_RADIUSOFGYRATION][c] += result.radiusofGyration;
+		sumSq[Q_RADIUSOFGYRATION][c] += result.radiusofGyration
+			                            * result.radiusofGyration;
+		sum[Q_ASPHERICITY][c] += result.asphericity;
+		sumSq[Q_ASPHERICITY][c] += result.asphericity * result.asphericity;
+		blockSum[block][c] += result.radiusofGyration;
+	}
+
+	blockCount[block]++;
+	sampleCount++;
+}
+
+// Fits <s^2> ~ N^(2 nu) by weighted least squares on the log-log
+// data and keeps nu. Its error comes from refitting with each
+// jackknife group left out in turn.
+//
+void scalingTrajectory::fitExponent()
+{
+	double averages[MAX_CHECKPOINTS], weights[MAX_CHECKPOINTS];
+	bool weighted = true;
+
+	exponent = 0.0;
+	exponentError = 0.0;
+
+	if(checkpointCount < 2 || sampleCount < 1)
+	{
+		return;
+	}
+
+	// Without a spread to weight by every point counts the same
+	for(int c = 0; c < checkpointCount; c++)
+	{
+		if(!(getDeviation(Q_RADIUSOFGYRATION, c) > 0.0))
+		{
+			weighted = false;
+		}
+	}
+
+	for(int c = 0; c < checkpointCount; c++)
+	{
+		averages[c] = getAverage(Q_RADIUSOFGYRATION, c);
+		weights[c] = 1.0;
+
+		if(weighted)
+		{
+			double sigma = getDeviation(Q_RADIUSOFGYRATION, c) 
+						   / averages[c];
+			weights[c] = 1.0 / (sigma * sigma);
+		}
+	}
+
+	exponent = fitSlope(averages, weights) / 2.0;
+
+	// Fit again without each group, keeping the same weights
+	double fits[JACKKNIFE_BLOCKS];
+	int fitCount = 0;
+
+	for(int b = 0; b < JACKKNIFE_BLOCKS; b++)
+	{
+		int kept = sampleCount - blockCount[b];
+
+		if(blockCount[b] == 0 || kept < 1)
+		{
+			continue;
+		}
+
+		for(int c = 0; c < checkpointCount; c++)
+		{
+			averages[c] = (sum[Q_RADIUSOFGYRATION][c] - blockSum[b][c]) 
+						  / kept;
+		}
+
+		fits[fitCount] = fitSlope(averages, weights) / 2.0;
+		fitCount++;
+	}
+
+	if(fitCount < 2)
+	{
+		return;
+	}
+
+	double mean = 0.0, spread = 0.0;
+
+	for(int f = 0; f < fitCount; f++)
+	{
+		mean += fits[f];
+	}
+
+	mean = mean / fitCount;
+
+	for(int f = 0; f < fitCount; f++)
+	{
+		spread += (fits[f] - mean) * (fits[f] - mean);
+	}
+
+	exponentError = sqrt(spread * (fitCount - 1) / fitCount);
+}
+
+// Returns the weighted least squares slope of log <s^2> against log N
+//
+double scalingTrajectory::fitSlope(const double* averages, 
+								   const double* weights)
+{
+	double s = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+
+	for(int c = 0; c < checkpointCount; c++)
+	{
+		double x = log((double)getBeads(c)), y = log(averages[c]);
+		double w = weights[c];
+
+		s += w;
+		sx += w * x;
+		sy += w * y;
+		sxx += w * x * x;
+		sxy += w * x * y;
+	}
+
+	return (s * sxy - sx * sy) / (s * sxx - sx * sx);
+}
+
+// Returns the average of a quantity at a checkpoint
+//
+double scalingTrajectory::getAverage(int quantity, int checkpoint)
+{
+	return sum[quantity][checkpoint] / sampleCount;
+}
+
+// Returns the standard deviation of the mean of a quantity at a
+// checkpoint, the same way main works it out for a single run.
+//
+double scalingTrajectory::getDeviation(int quantity, int checkpoint)
+{
+	double avg = sum[quantity][checkpoint] / sampleCount;
+	double avgSq = sumSq[quantity][checkpoint] / sampleCount;
+
+	if(sampleCount < 2 || avgSq - avg * avg <= 0.0)
+	{
+		return 0.0;
+	}
+
+	return sqrt((avgSq - avg * avg) / (sampleCount - 1));
+}
+
+// Below this point are all get functions
+int scalingTrajectory::getCheckpointCount()
+{
+	return checkpointCount;
+}
+
+int scalingTrajectory::getSampleCount()
+{
+	return sampleCount;
+}
+
+// Returns the bead amount of a checkpoint, counting the origin bead
+int scalingTrajectory::getBeads(int checkpoint)
+{
+	return 5 * armLength[checkpoint] + 1;
+}
+
+double scalingTrajectory::getLamda1(int checkpoint)
+{
+	return getAverage(Q_LAMDA1, checkpoint);
+}
+
+double scalingTrajectory::getLamda2(int checkpoint)
+{
+	return getAverage(Q_LAMDA2, checkpoint);
+}
+
+double scalingTrajectory::getRadiusofGyration(int checkpoint)
+{
+	return getAverage(Q_RADIUSOFGYRATION, checkpoint);
+}
+
+double scalingTrajectory::getAsphericity(int checkpoint)
+{
+	return getAverage(Q_ASPHERICITY, checkpoint);
+}
+
+double scalingTrajectory::getSdLamda1(int checkpoint)
+{
+	return getDeviation(Q_LAMDA1, checkpoint);
+}
+
+double scalingTrajectory::getSdLamda2(int checkpoint)
+{
+	return getDeviation(Q_LAMDA2, checkpoint);
+}
+
+double scalingTrajectory::getSdRadiusofGyration(int checkpoint)
+{
+	return getDeviation(Q_RADIUSOFGYRATION, checkpoint);
+}
+
+double scalingTrajectory::getSdAsphericity(int checkpoint)
+{
+	return getDeviation(Q_ASPHERICITY, checkpoint);
+}
+
+double scalingTrajectory::getExponent()
+{
+	return exponent;
+}
+
+double scalingTrajectory::getExponentError()
+{
+	return exponentError;
+}
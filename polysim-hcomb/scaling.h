@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      scaling.h                                           *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the scalingTrajectory class.                   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "moments.h"
+
+// Defines the maximum number of chain lengths one run can report.
+const int MAX_CHECKPOINTS = 64;
+
+// Defines how many groups the samples are dealt into for the
+// jackknife error on the exponent.
+const int JACKKNIFE_BLOCKS = 20;
+
+// Grows every H-Comb once up to the largest bead amount and takes a
+// snapshot of its shape each time it passes a checkpoint length.
+//
+// addBeads() grows the star first and arms 4 and 5 last, so a short
+// comb is not the start of a long one. Here all five arms grow in
+// turn instead, each kept as its own running moments, with arms 4
+// and 5 stored relative to the head of arm 3 and moved there when a
+// snapshot is taken. Checkpoints sit at 5 * armLength + 1 beads,
+// where addBeads() gives every arm the same length, so each snapshot
+// is drawn from exactly the same ensemble as a separate run at that
+// bead amount.
+//
+// The checkpoints of one growth are strongly correlated, so the error
+// on the exponent does not come from the fit. The samples are dealt
+// into JACKKNIFE_BLOCKS groups and the fit is done again with each
+// group left out, and the spread of those fits gives the error.
+class scalingTrajectory
+{
+private:
+	int checkpointCount, sampleCount;
+	int armLength[MAX_CHECKPOINTS];
+	double sum[4][MAX_CHECKPOINTS];
+	double sumSq[4][MAX_CHECKPOINTS];
+	double blockSum[JACKKNIFE_BLOCKS][MAX_CHECKPOINTS];
+	int blockCount[JACKKNIFE_BLOCKS];
+	double exponent, exponentError;
+
+	double fitSlope(const double* averages, const double* weights);
+	double getAverage(int quantity, int checkpoint);
+	double getDeviation(int quantity, int checkpoint);
+
+public:
+	// Constructor and destructor
+	scalingTrajectory(int smallestBeads, int largestBeads, double ratio);
+	~scalingTrajectory(void);
+
+	// Functionality
+	void addSample();
+	void fitExponent();
+
+	// Gets and sets
+	int getCheckpointCount();
+	int getSampleCount();
+	int getBeads(int checkpoint);
+	double getLamda1(int checkpoint);
+	double getLamda2(int checkpoint);
+	double getRadiusofGyration(int checkpoint);
+	double getAsphericity(int checkpoint);
+	double getSdLamda1(int checkpoint);
+	double getSdLamda2(int checkpoint);
+	double getSdRadiusofGyration(int checkpoint);
+	double getSdAsphericity(int checkpoint);
+	double getExponent();
+	double getExponentError();
+};
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      streaming.cpp                                       *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the streamingGrowth class. *//
+//*  Every bead is added to the moments the moment it is placed and *//
+//*  then forgotten.                                                *//
+//*  The block table is 4^7 entries of 16 bytes, 256KB. That is too *//
+//*  big for L1 but sits in L2, and a lookup that misses L1 still   *//
+//*  costs less than the rand call that picks it.                   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "streaming.h"
+
+// 2^64, to turn the high half of a wide sum into a double
+const double WIDE_HIGH = 18446744073709551616.0;
+
+// Adds a signed 64 bit value to a wide sum, carrying out of the low
+// half and sign extending the value into the high half.
+//
+static inline void addWide(wideSum& sum, long long value)
+{
+	unsigned long long before = sum.low;
+
+	sum.low += (unsigned long long)value;
+	sum.high += (value < 0) ? -1 : 0;
+
+	if(sum.low < before)
+	{
+		sum.high++;
+	}
+}
+
+// Returns a wide sum as a double. A negative sum is negated first, as
+// adding its two halves directly would cancel away every digit of a
+// small one.
+//
+static double wideToDouble(const wideSum& sum)
+{
+	if(sum.high < 0)
+	{
+		unsigned long long low = ~sum.low + 1;
+		long long high = ~sum.high + ((low == 0) ? 1 : 0);
+
+		return -((double)high * WIDE_HIGH + (double)low);
+	}
+
+	return (double)sum.high * WIDE_HIGH + (double)sum.low;
+}
+
+// Constructor for a streaming grower. Block stepping is on when
+// blockSteps is above zero, with blocks of that many steps up to
+// BLOCK_STEPS. The full size is the fast one, smaller blocks are for
+// checking the table against chains short enough to enumerate.
+//
+streamingGrowth::streamingGrowth(int blockSteps)
+{
+	if(blockSteps < 0)
+	{
+		blockSteps = 0;
+	}
+
+	this->blockSteps = (blockSteps < BLOCK_STEPS) ? blockSteps 
+												  : BLOCK_STEPS;
+	blockMask = (1 << (2 * this->blockSteps)) - 1;
+	blocks = NULL;
+
+	if(this->blockSteps > 0)
+	{
+		buildBlocks();
+	}
+
+	reset();
+}
+
+// Destructor for a streaming grower.
+//
+streamingGrowth::~streamingGrowth(void)
+{
+	delete [] blocks;
+}
+
+// Works out the table entry for every pattern of blockSteps steps.
+// Step j of a pattern is bits 2j and 2j + 1, with 0 to 3 meaning
+// North, South, East and West as rand() % 4 + 1 does in growArm.
+//
+void streamingGrowth::buildBlocks()
+{
+	blocks = new blockStep[blockMask + 1];
+
+	for(int pattern = 0; pattern <= blockMask; pattern++)
+	{
+		blockStep& b = blocks[pattern];
+		int x = 0, y = 0;
+
+		b.sumX = 0;
+		b.sumY = 0;
+		b.sumXX = 0;
+		b.sumXY = 0;
+		b.sumYY = 0;
+		b.unused = 0;
+
+		for(int j = 0; j < blockSteps; j++)
+		{
+			switch((pattern >> (2 * j)) & 3)
+			{
+			case 0:
+				y = y + 1;
+				break;
+
+			case 1:
+				y = y - 1;
+				break;
+
+			case 2:
+				x = x + 1;
+				break;
+
+			default:
+				x = x - 1;
+			}
+
+			b.sumX = (short)(b.sumX + x);
+			b.sumY = (short)(b.sumY + y);
+			b.sumXX = (short)(b.sumXX + x * x);
+			b.sumXY = (short)(b.sumXY + x * y);
+			b.sumYY = (short)(b.sumYY + y * y);
+		}
+
+		b.dx = (short)x;
+		b.dy = (short)y;
+	}
+}
+
+// Starts a new chain with the single bead at the origin.
+//
+void streamingGrowth::reset()
+{
+	for(int a = 0; a < 5; a++)
+	{
+		headX[a] = 0;
+		headY[a] = 0;
+	}
+
+	beadCount = 1;
+	sumX = 0;
+	sumY = 0;
+	sumXX.low = 0;
+	sumXX.high = 0;
+	sumXY = sumXX;
+	sumYY = sumXX;
+}
+
+// Grows one bead on the end of an arm (0 to 4) in a random direction,
+// using the same directions as sample::growArm, and adds it to the
+// moments.
+//
+void streamingGrowth::growArm(int arm)
+{
+	long long x = headX[arm], y = headY[arm];
+
+	switch(rand() % 4 + 1)
+	{
+	case 1:
+		// Grow North
+		y = y + 1;
+		break;
+
+	case 2:
+		// Grow South
+		y = y - 1;
+		break;
+
+	case 3:
+		// Grow East
+		x = x + 1;
+		break;
+
+	case 4:
+		// Grow West
+		x = x - 1;
+		break;
+
+	default:;
+
+	}
+
+	headX[arm] = x;
+	headY[arm] = y;
+	beadCount++;
+	sumX += x;
+	sumY += y;
+	addWide(sumXX, x * x);
+	addWide(sumXY, x * y);
+	addWide(sumYY, y * y);
+}
+
+// Grows length beads on the end of an arm, blockSteps at a time from
+// the block table and the few left over one at a time.
+//
+void streamingGrowth::growArmBlocks(int arm, long long length)
+{
+	long long x = headX[arm], y = headY[arm];
+	long long steps = blockSteps;
+	long long blockAmount = length / steps;
+
+	for(long long i = 0; i < blockAmount; i++)
+	{
+		const blockStep& b = blocks[rand() & blockMask];
+
+		// The terms in the start alone and the rest are added apart,
+		// so neither can overflow for any start that fits in a bead
+		sumX += steps * x + b.sumX;
+		sumY += steps * y + b.sumY;
+		addWide(sumXX, steps * x * x);
+		addWide(sumXX, 2 * x * b.sumX + b.sumXX);
+		addWide(sumXY, steps * x * y);
+		addWide(sumXY, x * b.sumY + y * b.sumX + b.sumXY);
+		addWide(sumYY, steps * y * y);
+		addWide(sumYY, 2 * y * b.sumY + b.sumYY);
+
+		x += b.dx;
+		y += b.dy;
+	}
+
+	headX[arm] = x;
+	headY[arm] = y;
+	beadCount += blockAmount * steps;
+
+	for(long long i = blockAmount * steps; i < length; i++)
+	{
+		growArm(arm);
+	}
+}
+
+// Grows a chain of amount beads past the first, with the arm lengths
+// addBeads gives, and works out its shape.
+//
+void streamingGrowth::grow(long long amount, shape& result)
+{
+	long long armLength = amount / 5;
+	long long starBeads = amount - (armLength * 2);
+	int arm = 0;
+
+	reset();
+
+	if(blocks != NULL)
+	{
+		// Arms 1, 2 and 3 share the star beads as the turns would
+		for(arm = 0; arm < 3; arm++)
+		{
+			growArmBlocks(arm, starBeads / 3 + ((arm < starBeads % 3) 
+												? 1 : 0));
+		}
+	}
+	else
+	{
+		// The star, arms 1, 2 and 3 in turn
+		for(long long i = 0; i < starBeads; i++)
+		{
+			growArm(arm);
+			arm = (arm == 2) ? 0 : arm + 1;
+		}
+	}
+
+	// Arms 4 and 5 both start at the head of arm 3
+	headX[3] = headX[2];
+	headY[3] = headY[2];
+	headX[4] = headX[2];
+	headY[4] = headY[2];
+
+	if(blocks != NULL)
+	{
+		growArmBlocks(3, armLength);
+		growArmBlocks(4, armLength);
+	}
+	else
+	{
+		for(long long i = 0; i < armLength; i++)
+		{
+			growArm(3);
+			growArm(4);
+		}
+	}
+
+	// Gyration tensor about the center of mass
+	double n = (double)beadCount;
+	double xcm = sumX / n, ycm = sumY / n;
+
+	calculateTensorShape(wideToDouble(sumXX) / n - xcm * xcm,
+						 wideToDouble(sumXY) / n - xcm * ycm,
+						 wideToDouble(sumYY) / n - ycm * ycm, result);
+}
+
+// Returns the value to srand with before growing sample index of a
+// run, so every sample can be grown again on its own. The seed and
+// index are mixed with the splitmix64 finalizer so neighbouring
+// samples do not start from neighbouring rand states.
+//
+unsigned int getSampleSeed(unsigned int seed, int index)
+{
+	unsigned long long z = ((unsigned long long)seed << 32) 
+						   + (unsigned int)index + 0x9E3779B97F4A7C15ULL;
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return (unsigned int)(z ^ (z >> 31));
+}
+
+// Below this point are all get functions
+//
+long long streamingGrowth::getBeadCount()
+{
+	return beadCount;
+}
+
+bool streamingGrowth::isBlockStepping()
+{
+	return blocks != NULL;
+}
+
+int streamingGrowth::getBlockSteps()
+{
+	return blockSteps;
+}
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      streaming.h                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the streamingGrowth class.                     *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "moments.h"
+
+// A signed 128 bit sum kept as two 64 bit halves, since VS2008 has no
+// 128 bit integer. The value is high * 2^64 + low.
+struct wideSum
+{
+	unsigned long long low;
+	long long high;
+};
+
+// Bumped whenever a streamed sample could come out differently for the
+// same seed, so results kept from older versions are never reused.
+const int STREAMING_VERSION = 1;
+
+// Defines the most steps one block lookup grows. Two bits a step, so
+// 4^7 blocks take the 14 bits a single rand call always has even when
+// RAND_MAX is 32767. Smaller tables fit in L1 but need more rand calls
+// per bead. 200 chains of 10^6 beads took 1.27s with 5 steps, 1.08s
+// with 6 and 0.91s with 7.
+const int BLOCK_STEPS = 7;
+
+// What one pattern of block steps adds to a walk that starts at
+// the origin: where it ends, and the sums over the beads it places.
+struct blockStep
+{
+	short dx, dy;
+	short sumX, sumY;
+	short sumXX, sumXY, sumYY;
+	short unused;
+};
+
+// Grows H-Combs the same way addBeads does, with the same arm order
+// and the same rand calls, but keeps no beads at all. Only the five arm
+// heads and the moments of the chain so far are held, so a chain can
+// be far longer than MAX_BEADS and still fit in a few hundred bytes.
+// For the same rand state the shape comes out exactly as a sample's
+// would.
+//
+// With block stepping on, each arm is grown in one go and every lookup
+// in a table of all 4^k patterns of k steps places k beads from one
+// rand call, with k at most BLOCK_STEPS. A block starting at (x0, y0) adds
+// k * x0 + sumX to the sum of x, k * x0^2 + 2 * x0 * sumX + sumXX to
+// the sum of x^2, and so on, so the moments stay exact. The arms are
+// independent walks, so the chains have the same distribution as
+// before, but no longer the same rand calls as addBeads.
+//
+// The first moments are 64 bit. The second moments grow as the square
+// of the chain length, so they are summed in 128 bits and no chain
+// that fits in a long long can overflow them.
+class streamingGrowth
+{
+private:
+	long long headX[5];
+	long long headY[5];
+	long long beadCount;
+	long long sumX, sumY;
+	wideSum sumXX, sumXY, sumYY;
+	blockStep* blocks;
+	int blockSteps, blockMask;
+
+	void reset();
+	void buildBlocks();
+	void growArm(int arm);
+	void growArmBlocks(int arm, long long length);
+
+public:
+	// Constructor and destructor
+	streamingGrowth(int blockSteps);
+	~streamingGrowth(void);
+
+	// Functionality
+	void grow(long long amount, shape& result);
+
+	// Gets and sets
+	long long getBeadCount();
+	bool isBlockStepping();
+	int getBlockSteps();
+};
+
+// Functionality
+unsigned int getSampleSeed(unsigned int seed, int index);
@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      structurefactor.cpp                                 *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the structureFactor class. *//
+//*  Instead of the O(N^2) pair sum every sample is rasterized onto *//
+//*  a lattice grid and Fourier transformed, which costs            *//
+//*  O(L^2 log L) per sample. The samples are split between worker  *//
+//*  threads that each keep their own grid and bin sums.            *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include "structurefactor.h"
+#include "fft.h"
+#include "threads.h"
+
+const double PI = 3.14159265358979323846;
+
+// Everything a single worker needs. Each worker owns its grid,
+// transform and sums so nothing is shared while they run.
+struct structureFactorWork{
+	const int* beadsX;
+	const int* beadsY;
+	int beads;
+	int begin, end;
+	int gridSize, binCount;
+	const int* binIndex;
+	fft2D* fft;
+	double* grid;
+	double* sum;
+};
+
+// Transforms the samples [begin, end) and adds |rho(q)|^2 / N into
+// the worker's bin sums.
+//
+static void structureFactorWorker(void* args)
+{
+	structureFactorWork* w = (structureFactorWork*)args;
+	int L = w->gridSize;
+
+	for(int n = w->begin; n < w->end; n++)
+	{
+		const int* x = w->beadsX + (long long)n * w->beads;
+		const int* y = w->beadsY + (long long)n * w->beads;
+		int beads = w->beads;
+		int minX = x[0], minY = y[0];
+
+		// Only |rho(q)| is wanted so the sample can be shifted to
+		// sit in the corner of the grid.
+		for(int i = 1; i < beads; i++)
+		{
+			if(x[i] < minX)
+			{
+				minX = x[i];
+			}
+
+			if(y[i] < minY)
+			{
+				minY = y[i];
+			}
+		}
+
+		for(int i = 0; i < 2 * L * L; i++)
+		{
+			w->grid[i] = 0.0;
+		}
+
+		// Beads of a random walk may sit on top of one another, so
+		// the density is a count rather than a flag.
+		for(int i = 0; i < beads; i++)
+		{
+			int gx = x[i] - minX, gy = y[i] - minY;
+
+			w->grid[2 * (gy * L + gx)] += 1.0;
+		}
+
+		w->fft->transform(w->grid);
+
+		for(int i = 0; i < L * L; i++)
+		{
+			int bin = w->binIndex[i];
+
+			if(bin >= 0)
+			{
+				double re = w->grid[2 * i], im = w->grid[2 * i + 1];
+				w->sum[bin] += (re * re + im * im) / beads;
+			}
+		}
+	}
+}
+
+// Constructor for a structure factor. Nothing is known until
+// calculate has seen the samples.
+//
+structureFactor::structureFactor(void)
+{
+	gridSize = 0;
+	binCount = 0;
+	binIndex = 0;
+	sum = 0;
+	modes = 0;
+}
+
+// Destructor for a structure factor.
+//
+structureFactor::~structureFactor(void)
+{
+	delete [] binIndex;
+	delete [] sum;
+	delete [] modes;
+}
+
+// Works out the ensemble averaged S(q) over the given samples. The
+// coordinates of sample n start at n * beads in each array.
+//
+void structureFactor::calculate(const int* beadsX, const int* beadsY, 
+								int beads, int sampleAmt)
+{
+	int span = 1;
+
+	// The grid has to hold the widest sample of the whole ensemble
+	// and is padded to twice that for a finer q spacing.
+	for(int n = 0; n < sampleAmt; n++)
+	{
+		const int* sampleX = beadsX + (long long)n * beads;
+		const int* sampleY = beadsY + (long long)n * beads;
+		int minX = 0, maxX = 0, minY = 0, maxY = 0;
+
+		for(int i = 0; i < beads; i++)
+		{
+			int x = sampleX[i], y = sampleY[i];
+
+			if(x < minX)
+			{
+				minX = x;
+			}
+
+			if(x > maxX)
+			{
+				maxX = x;
+			}
+
+			if(y < minY)
+			{
+				minY = y;
+			}
+
+			if(y > maxY)
+			{
+				maxY = y;
+			}
+		}
+
+		if(maxX - minX + 1 > span)
+		{
+			span = maxX - minX + 1;
+		}
+
+		if(maxY - minY + 1 > span)
+		{
+			span = maxY - minY + 1;
+		}
+	}
+
+	delete [] binIndex;
+	delete [] sum;
+	delete [] modes;
+
+	gridSize = nextPowerOfTwo(2 * span);
+	binCount = gridSize / 2;
+	binIndex = new int[gridSize * gridSize];
+	sum = new double[binCount];
+	modes = new int[binCount];
+
+	for(int b = 0; b < binCount; b++)
+	{
+		sum[b] = 0.0;
+		modes[b] = 0;
+	}
+
+	// Bin b holds the wave vectors whose length rounds to (b + 1)
+	// grid units. q = 0 and the corners past Nyquist are left out.
+	for(int j = 0; j < gridSize; j++)
+	{
+		int ky = (j < gridSize / 2) ? j : j - gridSize;
+
+		for(int i = 0; i < gridSize; i++)
+		{
+			int kx = (i < gridSize / 2) ? i : i - gridSize;
+			int bin = (int)(sqrt((double)(kx * kx + ky * ky)) + 0.5) - 1;
+
+			if(bin < 0 || bin >= binCount)
+			{
+				bin = -1;
+			}
+			else
+			{
+				modes[bin]++;
+			}
+
+			binIndex[j * gridSize + i] = bin;
+		}
+	}
+
+	// Split the samples evenly between the workers
+	int threadCount = getWorkerCount(sampleAmt);
+	structureFactorWork work[MAX_THREADS];
+	void* args[MAX_THREADS];
+
+	for(int t = 0; t < threadCount; t++)
+	{
+		work[t].beadsX = beadsX;
+		work[t].beadsY = beadsY;
+		work[t].beads = beads;
+		work[t].begin = (int)((long long)sampleAmt * t / threadCount);
+		work[t].end = (int)((long long)sampleAmt * (t + 1) / threadCount);
+		work[t].gridSize = gridSize;
+		work[t].binCount = binCount;
+		work[t].binIndex = binIndex;
+		work[t].fft = new fft2D(gridSize);
+		work[t].grid = work[t].fft->newGrid();
+		work[t].sum = new double[binCount];
+
+		for(int b = 0; b < binCount; b++)
+		{
+			work[t].sum[b] = 0.0;
+		}
+
+		args[t] = &work[t];
+	}
+
+	runThreads(threadCount, structureFactorWorker, args);
+
+	// Combine the workers and turn the sums into averages
+	for(int t = 0; t < threadCount; t++)
+	{
+		for(int b = 0; b < binCount; b++)
+		{
+			sum[b] += work[t].sum[b];
+		}
+
+		work[t].fft->deleteGrid(work[t].grid);
+		delete work[t].fft;
+		delete [] work[t].sum;
+	}
+
+	for(int b = 0; b < binCount; b++)
+	{
+		if(modes[b] > 0 && sampleAmt > 0)
+		{
+			sum[b] = sum[b] / ((double)modes[b] * sampleAmt);
+		}
+	}
+}
+
+// Below this point are all get functions
+int structureFactor::getGridSize()
+{
+	return gridSize;
+}
+
+int structureFactor::getBinCount()
+{
+	return binCount;
+}
+
+// Returns the centre wave number of a bin
+double structureFactor::getQ(int bin)
+{
+	return 2.0 * PI * (bin + 1) / gridSize;
+}
+
+double structureFactor::getS(int bin)
+{
+	return sum[bin];
+}
+
+int structureFactor::getModes(int bin)
+{
+	return modes[bin];
+}
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      structurefactor.h                                   *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the structureFactor class.                     *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+
+// Works out the ensemble averaged static structure factor S(q) of a
+// set of samples, given as their coordinates. Every sample is laid
+// onto a padded square grid, transformed and |rho(q)|^2 / N is added
+// into radial bins of width 2pi / gridSize out to the Nyquist wave
+// number pi.
+class structureFactor
+{
+private:
+	int gridSize, binCount;
+	int* binIndex;
+	double* sum;
+	int* modes;
+
+public:
+	// Constructor and destructor
+	structureFactor(void);
+	~structureFactor(void);
+
+	// Functionality
+	void calculate(const int* beadsX, const int* beadsY, int beads, 
+				   int sampleAmt);
+
+	// Gets and sets
+	int getGridSize();
+	int getBinCount();
+	double getQ(int bin);
+	double getS(int bin);
+	int getModes(int bin);
+};
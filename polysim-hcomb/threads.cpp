@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      threads.cpp                                         *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Portable threading helpers. Win32 threads are used on Windows  *//
+//*  and pthreads everywhere else, so the rest of the program never *//
+//*  has to know which one it is running on.                        *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+#endif
+#include "threads.h"
+
+// Holds what a single worker needs to know when it starts
+struct threadStart{
+	threadFunction func;
+	void* args;
+};
+
+// A thread from startThread along with what it was started with
+struct threadHandle{
+	threadStart start;
+#ifdef _WIN32
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+};
+
+#ifdef _WIN32
+static DWORD WINAPI threadEntry(LPVOID p)
+{
+	threadStart* start = (threadStart*)p;
+	start->func(start->args);
+	return 0;
+}
+#else
+static void* threadEntry(void* p)
+{
+	threadStart* start = (threadStart*)p;
+	start->func(start->args);
+	return 0;
+}
+#endif
+
+// Returns the number of processors available to the program.
+//
+int getProcessorCount()
+{
+	int count;
+
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	count = (int)info.dwNumberOfProcessors;
+#else
+	count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	if(count < 1)
+	{
+		count = 1;
+	}
+
+	return count;
+}
+
+// Returns how many workers to start for a given amount of jobs.
+// Never more than the processors, the jobs or MAX_THREADS.
+//
+int getWorkerCount(int jobs)
+{
+	int count = getProcessorCount();
+
+	if(count > MAX_THREADS)
+	{
+		count = MAX_THREADS;
+	}
+
+	if(count > jobs)
+	{
+		count = jobs;
+	}
+
+	if(count < 1)
+	{
+		count = 1;
+	}
+
+	return count;
+}
+
+// Runs func once per worker, handing worker i the argument args[i],
+// and waits for all of them to finish. A single worker is run on the
+// calling thread so the serial case costs nothing extra.
+//
+void runThreads(int threadCount, threadFunction func, void* args[])
+{
+	threadStart starts[MAX_THREADS];
+
+	if(threadCount > MAX_THREADS)
+	{
+		threadCount = MAX_THREADS;
+	}
+
+	if(threadCount <= 1)
+	{
+		func(args[0]);
+		return;
+	}
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		starts[i].func = func;
+		starts[i].args = args[i];
+	}
+
+#ifdef _WIN32
+	HANDLE handles[MAX_THREADS];
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		handles[i] = CreateThread(NULL, 0, threadEntry, &starts[i], 0, NULL);
+	}
+
+	WaitForMultipleObjects(threadCount, handles, TRUE, INFINITE);
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		CloseHandle(handles[i]);
+	}
+#else
+	pthread_t handles[MAX_THREADS];
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		pthread_create(&handles[i], NULL, threadEntry, &starts[i]);
+	}
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		pthread_join(handles[i], NULL);
+	}
+#endif
+}
+
+// Starts func on a thread of its own and returns straight away. Every
+// thread started has to be handed to joinThread once.
+//
+threadHandle* startThread(threadFunction func, void* args)
+{
+	threadHandle* thread = new threadHandle;
+
+	thread->start.func = func;
+	thread->start.args = args;
+
+#ifdef _WIN32
+	thread->handle = CreateThread(NULL, 0, threadEntry, &thread->start, 
+								  0, NULL);
+#else
+	pthread_create(&thread->handle, NULL, threadEntry, &thread->start);
+#endif
+
+	return thread;
+}
+
+// Waits for a thread from startThread to finish and frees it.
+//
+void joinThread(threadHandle* thread)
+{
+	if(thread == NULL)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+
+	delete thread;
+}
+
+// Adds amount to value as one step no other thread can split and
+// returns the new value.
+//
+long atomicAdd(volatile long* value, long amount)
+{
+#ifdef _WIN32
+	return InterlockedExchangeAdd(value, amount) + amount;
+#else
+	return __sync_add_and_fetch(value, amount);
+#endif
+}
+
+// Puts the calling thread to sleep.
+//
+void sleepMilliseconds(int milliseconds)
+{
+#ifdef _WIN32
+	Sleep(milliseconds);
+#else
+	usleep(milliseconds * 1000);
+#endif
+}
+
+// Returns wall clock seconds from some fixed point. Unlike clock this
+// keeps counting while the program waits and does not add up the time
+// of every thread.
+//
+double getWallSeconds()
+{
+#ifdef _WIN32
+	LARGE_INTEGER count, frequency;
+
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+	timeval now;
+
+	gettimeofday(&now, NULL);
+
+	return now.tv_sec + now.tv_usec * 1e-6;
+#endif
+}
+
+// Constructor for a lock.
+//
+threadLock::threadLock(void)
+{
+#ifdef _WIN32
+	CRITICAL_SECTION* section = new CRITICAL_SECTION;
+	InitializeCriticalSection(section);
+	handle = section;
+#else
+	pthread_mutex_t* mutex = new pthread_mutex_t;
+	pthread_mutex_init(mutex, NULL);
+	handle = mutex;
+#endif
+}
+
+// Destructor for a lock.
+//
+threadLock::~threadLock(void)
+{
+#ifdef _WIN32
+	DeleteCriticalSection((CRITICAL_SECTION*)handle);
+	delete (CRITICAL_SECTION*)handle;
+#else
+	pthread_mutex_destroy((pthread_mutex_t*)handle);
+	delete (pthread_mutex_t*)handle;
+#endif
+}
+
+// Takes the lock, waiting for whoever holds it.
+//
+void threadLock::lock()
+{
+#ifdef _WIN32
+	EnterCriticalSection((CRITICAL_SECTION*)handle);
+#else
+	pthread_mutex_lock((pthread_mutex_t*)handle);
+#endif
+}
+
+// Gives the lock back.
+//
+void threadLock::unlock()
+{
+#ifdef _WIN32
+	LeaveCriticalSection((CRITICAL_SECTION*)handle);
+#else
+	pthread_mutex_unlock((pthread_mutex_t*)handle);
+#endif
+}
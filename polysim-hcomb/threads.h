@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      threads.h                                           *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the small set of portable threading helpers.   *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Defines the maximum number of worker threads we will ever start.
+const int MAX_THREADS = 16;
+
+// The signature every worker function must have. The argument is
+// whatever the caller handed to runThreads for that worker.
+typedef void (*threadFunction)(void* args);
+
+// A thread started with startThread, only ever handled through a
+// pointer. joinThread waits for it and frees it.
+struct threadHandle;
+
+// A lock around short critical sections. The system object behind it
+// is kept out of this header so windows.h is not pulled in everywhere.
+class threadLock
+{
+private:
+	void* handle;
+
+	threadLock(const threadLock&);
+	threadLock& operator=(const threadLock&);
+
+public:
+	// Constructor and destructor
+	threadLock(void);
+	~threadLock(void);
+
+	// Functionality
+	void lock();
+	void unlock();
+};
+
+// Functionality
+int getProcessorCount();
+int getWorkerCount(int jobs);
+void runThreads(int threadCount, threadFunction func, void* args[]);
+threadHandle* startThread(threadFunction func, void* args);
+void joinThread(threadHandle* thread);
+long atomicAdd(volatile long* value, long amount);
+void sleepMilliseconds(int milliseconds);
+double getWallSeconds();
@@ -0,0 +1,721 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      wanglandau.cpp                                      *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  This is the implementation code for the wangLandau class.      *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <math.h>
+#include "wanglandau.h"
+
+// Defines the attempted moves per bead used to cool the first walker
+// and find the range of contact counts.
+const int EXPLORE_SWEEPS = 20000;
+
+// Temperatures the first walker is cooled between
+const double EXPLORE_HOT = 3.0;
+const double EXPLORE_COLD = 0.15;
+
+// Defines the fewest contact counts a window is ever given
+const int MIN_WINDOW_BINS = 4;
+
+// What a window thread needs to know when it starts
+struct windowJob{
+	wangLandau* owner;
+	int window;
+};
+
+// Constructor for a Wang-Landau run. The range of contact counts is
+// found and every window is given a walker inside it straight away,
+// so run only has to sample.
+//
+wangLandau::wangLandau(sample* s, int windowCount,
+					   double finalModification)
+{
+	int size = s->getBeadCount() + 2;
+
+	beadCount = s->getBeadCount();
+	this->finalModification = finalModification;
+	accumulateModification = sqrt(finalModification);
+	rounds = 0;
+	exchangesTried = 0;
+	exchangesAccepted = 0;
+
+	densityOfStates = new double[size];
+	reached = new bool[size];
+	averageRadiusofGyration = new double[size];
+	averageAsphericity = new double[size];
+	sampleCount = new long long[size];
+
+	for(int m = 0; m < size; m++)
+	{
+		densityOfStates[m] = 0.0;
+		reached[m] = false;
+		averageRadiusofGyration[m] = 0.0;
+		averageAsphericity[m] = 0.0;
+		sampleCount[m] = 0;
+	}
+
+	explore(s, windowCount);
+
+	for(int w = 0; w < this->windowCount; w++)
+	{
+		modification[w] = 1.0;
+		finished[w] = false;
+		inverseTime[w] = false;
+		binsVisited[w] = 0;
+		moveTime[w] = 0;
+		movesTried[w] = 0;
+		movesAccepted[w] = 0;
+
+		lnG[w] = new double[size];
+		histogram[w] = new long long[size];
+		visited[w] = new bool[size];
+		sumRadiusofGyration[w] = new double[size];
+		sumAsphericity[w] = new double[size];
+		sumCount[w] = new long long[size];
+
+		for(int m = 0; m < size; m++)
+		{
+			lnG[w][m] = 0.0;
+			histogram[w][m] = 0;
+			visited[w][m] = false;
+			sumRadiusofGyration[w][m] = 0.0;
+			sumAsphericity[w][m] = 0.0;
+			sumCount[w][m] = 0;
+		}
+	}
+}
+
+// Destructor for a Wang-Landau run.
+//
+wangLandau::~wangLandau(void)
+{
+	for(int w = 0; w < windowCount; w++)
+	{
+		delete walkers[w];
+		delete [] lnG[w];
+		delete [] histogram[w];
+		delete [] visited[w];
+		delete [] sumRadiusofGyration[w];
+		delete [] sumAsphericity[w];
+		delete [] sumCount[w];
+	}
+
+	delete [] densityOfStates;
+	delete [] reached;
+	delete [] averageRadiusofGyration;
+	delete [] averageAsphericity;
+	delete [] sampleCount;
+}
+
+// Cools one walker from the straight comb with ordinary Metropolis
+// moves and keeps the first conformation seen at every contact count.
+// The highest count reached sets the range the windows cover, and the
+// kept conformations are where the window walkers start.
+//
+void wangLandau::explore(sample* s, int requested)
+{
+	int size = beadCount + 2;
+	long long moves = (long long)EXPLORE_SWEEPS * beadCount;
+	double cooling = pow(EXPLORE_COLD / EXPLORE_HOT, 1.0 / moves);
+	double temperature = EXPLORE_HOT;
+	combWalker* explorer = new combWalker(s, getWalkerSeed());
+
+	int** keptX = new int*[size];
+	int** keptY = new int*[size];
+
+	for(int m = 0; m < size; m++)
+	{
+		keptX[m] = NULL;
+		keptY[m] = NULL;
+	}
+
+	for(long long t = 0; t <= moves; t++)
+	{
+		int before = explorer->getContacts();
+
+		if(t > 0 && explorer->tryMove())
+		{
+			int change = explorer->getContacts() - before;
+
+			if(change >= 0
+				|| explorer->randomUniform() < exp(change / temperature))
+			{
+				explorer->accept();
+			}
+			else
+			{
+				explorer->undo();
+			}
+		}
+
+		int m = explorer->getContacts();
+
+		if(keptX[m] == NULL)
+		{
+			keptX[m] = new int[beadCount];
+			keptY[m] = new int[beadCount];
+
+			for(int i = 0; i < beadCount; i++)
+			{
+				keptX[m][i] = explorer->getBeadX(i);
+				keptY[m][i] = explorer->getBeadY(i);
+			}
+		}
+
+		temperature *= cooling;
+	}
+
+	maxContacts = 0;
+
+	for(int m = 0; m < size; m++)
+	{
+		if(keptX[m] != NULL)
+		{
+			maxContacts = m;
+		}
+	}
+
+	// Every window starts from the kept conformation nearest the
+	// middle of the range it covers
+	setWindows(requested);
+
+	for(int w = 0; w < windowCount; w++)
+	{
+		int middle = (windowLow[w] + windowHigh[w]) / 2, nearest = 0;
+
+		if(middle > maxContacts)
+		{
+			middle = (windowLow[w] + maxContacts) / 2;
+		}
+
+		for(int m = 0; m <= maxContacts; m++)
+		{
+			if(keptX[m] != NULL && abs(m - middle) < abs(nearest - middle))
+			{
+				nearest = m;
+			}
+		}
+
+		walkers[w] = new combWalker(s, getWalkerSeed());
+		walkers[w]->setConformation(keptX[nearest], keptY[nearest]);
+	}
+
+	for(int m = 0; m < size; m++)
+	{
+		delete [] keptX[m];
+		delete [] keptY[m];
+	}
+
+	delete [] keptX;
+	delete [] keptY;
+	delete explorer;
+}
+
+// Cuts the contact counts from 0 up into overlapping windows, no more
+// than asked for and no fewer than MIN_WINDOW_BINS counts wide. The
+// last window is left open up to the most contacts any comb could
+// have, so counts the cooling never found can still be sampled.
+//
+void wangLandau::setWindows(int requested)
+{
+	int range = maxContacts + 1;
+
+	windowCount = requested;
+
+	if(windowCount > MAX_THREADS)
+	{
+		windowCount = MAX_THREADS;
+	}
+
+	if(windowCount > range / MIN_WINDOW_BINS)
+	{
+		windowCount = range / MIN_WINDOW_BINS;
+	}
+
+	if(windowCount < 1)
+	{
+		windowCount = 1;
+	}
+
+	int width = (int)ceil(range / (1.0 + (windowCount - 1)
+						  * (1.0 - WINDOW_OVERLAP)));
+	double step = (windowCount > 1)
+				  ? (double)(range - width) / (windowCount - 1) : 0.0;
+
+	for(int w = 0; w < windowCount; w++)
+	{
+		windowLow[w] = (int)(w * step + 0.5);
+		windowHigh[w] = windowLow[w] + width - 1;
+	}
+
+	windowHigh[windowCount - 1] = beadCount + 1;
+}
+
+// Runs the windows until every one of them has reached the final
+// modification factor, then joins them.
+//
+void wangLandau::run()
+{
+	windowJob jobs[MAX_THREADS];
+	void* args[MAX_THREADS];
+
+	for(int w = 0; w < windowCount; w++)
+	{
+		jobs[w].owner = this;
+		jobs[w].window = w;
+		args[w] = &jobs[w];
+	}
+
+	while(true)
+	{
+		bool allFinished = true;
+
+		for(int w = 0; w < windowCount; w++)
+		{
+			if(!finished[w])
+			{
+				allFinished = false;
+			}
+		}
+
+		if(allFinished)
+		{
+			break;
+		}
+
+		runThreads(windowCount, windowEntry, args);
+		exchangeReplicas((int)(rounds % 2));
+
+		for(int w = 0; w < windowCount; w++)
+		{
+			if(!finished[w])
+			{
+				updateModification(w);
+			}
+		}
+
+		rounds++;
+	}
+
+	joinWindows();
+}
+
+// Where each window thread starts.
+//
+void wangLandau::windowEntry(void* args)
+{
+	windowJob* job = (windowJob*)args;
+
+	job->owner->runWindow(job->window);
+}
+
+// Makes one round of Wang-Landau moves in a window. A move is kept
+// with probability g(before) / g(after), never if it leaves the
+// window, and ln g and the histogram at wherever the walker ends up
+// are raised after every attempt. A walker that is still outside its
+// window takes any move that does not carry it further away.
+//
+void wangLandau::runWindow(int w)
+{
+	combWalker* walker = walkers[w];
+	int low = windowLow[w], high = windowHigh[w];
+	long long moves = (long long)ROUND_SWEEPS * beadCount;
+	bool accumulate = modification[w] <= accumulateModification;
+	shape result;
+
+	if(finished[w])
+	{
+		return;
+	}
+
+	for(long long t = 0; t < moves; t++)
+	{
+		int before = walker->getContacts();
+
+		moveTime[w]++;
+
+		if(inverseTime[w])
+		{
+			modification[w] = (double)binsVisited[w] / moveTime[w];
+		}
+
+		if(walker->tryMove())
+		{
+			int after = walker->getContacts();
+			bool keep;
+
+			movesTried[w]++;
+
+			if(before < low || before > high)
+			{
+				int distanceBefore = (before < low) ? low - before
+													: before - high;
+				int distanceAfter = (after < low) ? low - after
+							   : (after > high) ? after - high : 0;
+
+				keep = distanceAfter <= distanceBefore;
+			}
+			else if(after < low || after > high)
+			{
+				keep = false;
+			}
+			else
+			{
+				double change = lnG[w][before] - lnG[w][after];
+
+				keep = change >= 0.0
+					   || walker->randomUniform() < exp(change);
+			}
+
+			if(keep)
+			{
+				walker->accept();
+				movesAccepted[w]++;
+			}
+			else
+			{
+				walker->undo();
+			}
+		}
+
+		int m = walker->getContacts();
+
+		if(m >= low && m <= high)
+		{
+			lnG[w][m] += modification[w];
+			histogram[w][m]++;
+			visited[w][m] = true;
+
+			if(accumulate)
+			{
+				walker->getShape(result);
+				sumRadiusofGyration[w][m] += result.radiusofGyration;
+				sumAsphericity[w][m] += result.asphericity;
+				sumCount[w][m]++;
+			}
+		}
+	}
+}
+
+// Offers the walkers of every other pair of neighbouring windows a
+// swap, starting from the first or the second window by parity. A
+// swap is taken with the usual replica exchange probability, and only
+// when each walker is inside the other's window.
+//
+void wangLandau::exchangeReplicas(int parity)
+{
+	for(int w = parity; w + 1 < windowCount; w += 2)
+	{
+		int a = walkers[w]->getContacts(), b = walkers[w + 1]->getContacts();
+
+		if(finished[w] || finished[w + 1]
+			|| a < windowLow[w] || a > windowHigh[w]
+			|| b < windowLow[w + 1] || b > windowHigh[w + 1])
+		{
+			continue;
+		}
+
+		exchangesTried++;
+
+		if(a < windowLow[w + 1] || b > windowHigh[w])
+		{
+			continue;
+		}
+
+		double change = lnG[w][a] - lnG[w][b]
+						+ lnG[w + 1][b] - lnG[w + 1][a];
+
+		if(change >= 0.0 || walkers[w]->randomUniform() < exp(change))
+		{
+			combWalker* swap = walkers[w];
+			walkers[w] = walkers[w + 1];
+			walkers[w + 1] = swap;
+			exchangesAccepted++;
+		}
+	}
+}
+
+// Moves a window on after a round. While its histogram is what sets
+// the pace, the factor is halved each time it goes flat, until that
+// would put it under visited counts / moves. From then on the factor
+// is simply visited counts / moves, worked out on every move. The
+// window is finished once the factor is below the final one.
+//
+void wangLandau::updateModification(int w)
+{
+	binsVisited[w] = 0;
+
+	for(int m = windowLow[w]; m <= windowHigh[w]; m++)
+	{
+		if(visited[w][m])
+		{
+			binsVisited[w]++;
+		}
+	}
+
+	double inverse = (double)binsVisited[w] / moveTime[w];
+
+	if(!inverseTime[w] && isFlat(w))
+	{
+		modification[w] /= 2.0;
+
+		for(int m = windowLow[w]; m <= windowHigh[w]; m++)
+		{
+			histogram[w][m] = 0;
+		}
+
+		if(modification[w] < inverse)
+		{
+			inverseTime[w] = true;
+			modification[w] = inverse;
+		}
+	}
+
+	if(modification[w] < finalModification)
+	{
+		finished[w] = true;
+	}
+}
+
+// Returns true when every contact count the window has ever visited
+// has been seen at least FLATNESS of the average since the last
+// modification factor change.
+//
+bool wangLandau::isFlat(int w)
+{
+	long long sum = 0, least = -1;
+	int count = 0;
+
+	for(int m = windowLow[w]; m <= windowHigh[w]; m++)
+	{
+		if(visited[w][m])
+		{
+			sum += histogram[w][m];
+			count++;
+
+			if(least < 0 || histogram[w][m] < least)
+			{
+				least = histogram[w][m];
+			}
+		}
+	}
+
+	return count > 0 && least > 0 && least >= FLATNESS * sum / count;
+}
+
+// Joins the ln g of every window onto the one below it at the count in
+// their overlap where the two slopes agree best, sets ln g(0) to zero
+// and works out the average s^2 and A at every count from all windows.
+//
+void wangLandau::joinWindows()
+{
+	int size = beadCount + 2;
+
+	for(int m = windowLow[0]; m <= windowHigh[0]; m++)
+	{
+		reached[m] = visited[0][m];
+		densityOfStates[m] = lnG[0][m];
+	}
+
+	for(int w = 1; w < windowCount; w++)
+	{
+		int join = -1;
+		double best = 0.0;
+
+		for(int m = windowLow[w] + 1; m < windowHigh[w - 1]; m++)
+		{
+			if(reached[m - 1] && reached[m + 1] && visited[w][m - 1]
+				&& visited[w][m + 1])
+			{
+				double difference = fabs((densityOfStates[m + 1]
+										  - densityOfStates[m - 1])
+										 - (lnG[w][m + 1] - lnG[w][m - 1]));
+
+				if(join < 0 || difference < best)
+				{
+					join = m;
+					best = difference;
+				}
+			}
+		}
+
+		// Too little overlap for slopes, so any shared count will do
+		for(int m = windowLow[w]; join < 0 && m <= windowHigh[w - 1]; m++)
+		{
+			if(reached[m] && visited[w][m])
+			{
+				join = m;
+			}
+		}
+
+		double shift = 0.0;
+
+		if(join < 0)
+		{
+			join = windowLow[w];
+		}
+		else
+		{
+			shift = densityOfStates[join] - lnG[w][join];
+		}
+
+		for(int m = join; m <= windowHigh[w]; m++)
+		{
+			reached[m] = visited[w][m];
+			densityOfStates[m] = lnG[w][m] + shift;
+		}
+	}
+
+	double origin = reached[0] ? densityOfStates[0] : 0.0;
+
+	maxContacts = 0;
+
+	for(int m = 0; m < size; m++)
+	{
+		double sumR = 0.0, sumA = 0.0;
+		long long count = 0;
+
+		densityOfStates[m] -= origin;
+
+		if(reached[m])
+		{
+			maxContacts = m;
+		}
+
+		for(int w = 0; w < windowCount; w++)
+		{
+			sumR += sumRadiusofGyration[w][m];
+			sumA += sumAsphericity[w][m];
+			count += sumCount[w][m];
+		}
+
+		sampleCount[m] = count;
+
+		if(count > 0)
+		{
+			averageRadiusofGyration[m] = sumR / count;
+			averageAsphericity[m] = sumA / count;
+		}
+	}
+}
+
+// Reweights to a temperature: the average energy, the heat capacity
+// and the average s^2 and A, with the Boltzmann constant and the
+// contact energy both taken as one.
+//
+void wangLandau::reweight(double temperature, double& energy,
+						  double& heatCapacity, double& radiusofGyration,
+						  double& asphericity)
+{
+	double largest = 0.0, z = 0.0, e = 0.0, e2 = 0.0;
+	double zShape = 0.0, r = 0.0, a = 0.0;
+	bool first = true;
+
+	// Largest exponent first so nothing overflows
+	for(int m = 0; m <= maxContacts; m++)
+	{
+		if(reached[m] && (first
+			|| densityOfStates[m] + m / temperature > largest))
+		{
+			largest = densityOfStates[m] + m / temperature;
+			first = false;
+		}
+	}
+
+	for(int m = 0; m <= maxContacts; m++)
+	{
+		if(!reached[m])
+		{
+			continue;
+		}
+
+		double weight = exp(densityOfStates[m] + m / temperature - largest);
+
+		z += weight;
+		e += weight * -m;
+		e2 += weight * m * m;
+
+		if(sampleCount[m] > 0)
+		{
+			zShape += weight;
+			r += weight * averageRadiusofGyration[m];
+			a += weight * averageAsphericity[m];
+		}
+	}
+
+	energy = (z > 0.0) ? e / z : 0.0;
+	heatCapacity = (z > 0.0)
+				   ? (e2 / z - energy * energy) / (temperature * temperature)
+				   : 0.0;
+	radiusofGyration = (zShape > 0.0) ? r / zShape : 0.0;
+	asphericity = (zShape > 0.0) ? a / zShape : 0.0;
+}
+
+// Below this point are all get functions
+int wangLandau::getBeadCount()
+{
+	return beadCount;
+}
+
+int wangLandau::getWindowCount()
+{
+	return windowCount;
+}
+
+int wangLandau::getMaxContacts()
+{
+	return maxContacts;
+}
+
+long long wangLandau::getRounds()
+{
+	return rounds;
+}
+
+double wangLandau::getAcceptance()
+{
+	long long tried = 0, accepted = 0;
+
+	for(int w = 0; w < windowCount; w++)
+	{
+		tried += movesTried[w];
+		accepted += movesAccepted[w];
+	}
+
+	return (tried > 0) ? (double)accepted / tried : 0.0;
+}
+
+double wangLandau::getExchangeAcceptance()
+{
+	return (exchangesTried > 0)
+		   ? (double)exchangesAccepted / exchangesTried : 0.0;
+}
+
+bool wangLandau::isReached(int contacts)
+{
+	return reached[contacts];
+}
+
+double wangLandau::getLnG(int contacts)
+{
+	return densityOfStates[contacts];
+}
+
+long long wangLandau::getSampleCount(int contacts)
+{
+	return sampleCount[contacts];
+}
+
+double wangLandau::getAverageRadiusofGyration(int contacts)
+{
+	return averageRadiusofGyration[contacts];
+}
+
+double wangLandau::getAverageAsphericity(int contacts)
+{
+	return averageAsphericity[contacts];
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////
+//*                                                                 *//
+//*  File:      wanglandau.h                                        *//
+//*  Author:    Matt Perrelli                                       *//
+//*                                                                 *//
+//*  Header file for the wangLandau class.                          *//
+//*                                                                 *//
+///////////////////////////////////////////////////////////////////////
+#pragma once
+#include "sample.h"
+#include "combwalker.h"
+#include "threads.h"
+
+// Defines the attempted moves per bead each window makes between two
+// rounds of replica exchange and flatness checks.
+const int ROUND_SWEEPS = 100;
+
+// Defines how flat a histogram must be: every visited contact count
+// must have been seen at least this fraction of the average.
+const double FLATNESS = 0.8;
+
+// Defines how much of a window is shared with the next one
+const double WINDOW_OVERLAP = 0.75;
+
+// Works out the density of states g(m) of a self-avoiding H-Comb over
+// its number of contacts m, where each contact is worth an energy of
+// -1, by Wang-Landau flat histogram sampling.
+//
+// The range of contact counts is found first by cooling one walker
+// from the straight comb down to a compact one. It is then cut into
+// overlapping windows, each with a walker and a ln g of its own, run
+// on a thread of its own (replica exchange Wang-Landau). After every
+// round, walkers in neighbouring windows are offered a swap, and any
+// window whose histogram is flat halves its modification factor. Once
+// halving would take the factor below visited counts / moves, a window
+// switches to that 1/t factor instead (Belardinelli and Pereyra), so
+// its error keeps falling rather than freezing. When every window has
+// got below the final factor, the pieces of ln g are joined where
+// their slopes agree best.
+//
+// While the modification factor is small the walkers also add up s^2
+// and A at every contact count. With those and g, averages at any
+// temperature come from reweight without another run.
+class wangLandau
+{
+private:
+	int beadCount, windowCount, maxContacts;
+	double finalModification, accumulateModification;
+	long long rounds, exchangesTried, exchangesAccepted;
+
+	combWalker* walkers[MAX_THREADS];
+	int windowLow[MAX_THREADS];
+	int windowHigh[MAX_THREADS];
+	double modification[MAX_THREADS];
+	bool finished[MAX_THREADS];
+	bool inverseTime[MAX_THREADS];
+	int binsVisited[MAX_THREADS];
+	long long moveTime[MAX_THREADS];
+	long long movesTried[MAX_THREADS];
+	long long movesAccepted[MAX_THREADS];
+
+	// Per window, indexed by contact count
+	double* lnG[MAX_THREADS];
+	long long* histogram[MAX_THREADS];
+	bool* visited[MAX_THREADS];
+	double* sumRadiusofGyration[MAX_THREADS];
+	double* sumAsphericity[MAX_THREADS];
+	long long* sumCount[MAX_THREADS];
+
+	// Joined results, indexed by contact count
+	double* densityOfStates;
+	bool* reached;
+	double* averageRadiusofGyration;
+	double* averageAsphericity;
+	long long* sampleCount;
+
+	static void windowEntry(void* args);
+	void explore(sample* s, int requested);
+	void setWindows(int requested);
+	void runWindow(int w);
+	void exchangeReplicas(int parity);
+	bool isFlat(int w);
+	void updateModification(int w);
+	void joinWindows();
+
+public:
+	// Constructor and destructor
+	wangLandau(sample* s, int windowCount, double finalModification);
+	~wangLandau(void);
+
+	// Functionality
+	void run();
+	void reweight(double temperature, double& energy, double& heatCapacity,
+				  double& radiusofGyration, double& asphericity);
+
+	// Gets and sets
+	int getBeadCount();
+	int getWindowCount();
+	int getMaxContacts();
+	long long getRounds();
+	double getAcceptance();
+	double getExchangeAcceptance();
+	bool isReached(int contacts);
+	double getLnG(int contacts);
+	long long getSampleCount(int contacts);
+	double getAverageRadiusofGyration(int contacts);
+	double getAverageAsphericity(int contacts);
+};